@@ -0,0 +1,132 @@
+/**
+ * @file bench.c
+ * @brief Throughput benchmark for kv_get_value() and kv_file_get_value().
+ *
+ * Generates synthetic key-value inputs from 1 KB up to the size given on the command line (default 1 GB) and
+ * times a hit near the head, a hit near the tail and a miss. Results are printed as one JSON object per line,
+ * with throughput computed over the bytes each lookup has to read.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kv_file_get_value.h"
+#include "kv_get_value.h"
+#include <assert.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifndef KV_BENCH_FLAGS
+#define KV_BENCH_FLAGS "default"
+#endif
+
+/* Minimum measured time per case, so small inputs are repeated enough to time accurately */
+#define KV_BENCH_MIN_NS 200000000.0
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* Fills `buf` with roughly `size` bytes of "KEY_n=value" lines. Returns the number of lines written. */
+static unsigned long generate(char *buf, size_t size)
+{
+    unsigned long lines = 0;
+    size_t pos = 0;
+    for (;;)
+    {
+        char line[64];
+        int len = sprintf(line, "BENCH_KEY_%lu=some_value_for_key_%lu\n", lines, lines);
+        if (pos + len > size)
+        {
+            break;
+        }
+        memcpy(buf + pos, line, len);
+        pos += len;
+        lines++;
+    }
+    buf[pos] = '\0';
+    return lines;
+}
+
+static void report(const char *func, size_t size, size_t scanned, const char *lookup, double ns_per_lookup)
+{
+    printf("{\"flags\":\"%s\",\"func\":\"%s\",\"bytes\":%lu,\"case\":\"%s\",\"bytes_scanned\":%lu,\"ns_per_lookup\":%.1f,\"gb_per_s\":%.3f}\n",
+           KV_BENCH_FLAGS,
+           func,
+           (unsigned long)size,
+           lookup,
+           (unsigned long)scanned,
+           ns_per_lookup,
+           scanned / ns_per_lookup);
+    fflush(stdout);
+}
+
+int main(int argc, char *argv[])
+{
+    size_t max_bytes = argc > 1 ? strtoul(argv[1], NULL, 0) : 1024UL * 1024UL * 1024UL;
+
+    char *buf = malloc(max_bytes + 1);
+    assert(buf != NULL);
+
+    for (size_t size = 1024; size <= max_bytes; size *= 32)
+    {
+        const unsigned long lines = generate(buf, size);
+        const size_t used = strlen(buf);
+
+        char head[32], tail[32];
+        sprintf(head, "BENCH_KEY_%lu", 1UL);
+        sprintf(tail, "BENCH_KEY_%lu", lines - 1);
+        const char *keys[] = {head, tail, "BENCH_KEY_MISSING"};
+        const char *cases[] = {"head", "tail", "miss"};
+
+        /* Bytes a lookup has to read: up to the end of the second line for the head hit, everything otherwise */
+        const size_t scanned[] = {(size_t)(strchr(strchr(buf, '\n') + 1, '\n') - buf) + 1, used, used};
+
+        FILE *file = tmpfile();
+        assert(file != NULL);
+        fwrite(buf, 1, used, file);
+
+        for (int c = 0; c < 3; c++)
+        {
+            char value[64];
+            unsigned long iterations = 0;
+            double start = now_ns();
+            double elapsed = 0;
+            for (unsigned long batch = 1; elapsed < KV_BENCH_MIN_NS; batch *= 2)
+            {
+                for (unsigned long i = 0; i < batch; i++)
+                {
+                    kv_get_value(buf, keys[c], value, sizeof(value));
+                }
+                iterations += batch;
+                elapsed = now_ns() - start;
+            }
+            report("kv_get_value", used, scanned[c], cases[c], elapsed / iterations);
+
+            iterations = 0;
+            start = now_ns();
+            elapsed = 0;
+            for (unsigned long batch = 1; elapsed < KV_BENCH_MIN_NS; batch *= 2)
+            {
+                for (unsigned long i = 0; i < batch; i++)
+                {
+                    kv_file_get_value(file, keys[c], value, sizeof(value));
+                }
+                iterations += batch;
+                elapsed = now_ns() - start;
+            }
+            report("kv_file_get_value", used, scanned[c], cases[c], elapsed / iterations);
+        }
+
+        fclose(file);
+    }
+
+    free(buf);
+    return 0;
+}
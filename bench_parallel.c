@@ -0,0 +1,162 @@
+/**
+ * @file bench_parallel.c
+ * @brief Scaling benchmark for kv_index_build_parallel().
+ *
+ * Generates a synthetic key-value buffer of the size given on the command line (default 256 MB) and times
+ * kv_index_build_parallel() from 1 thread up to the thread count given as the second argument (default: the
+ * number of online CPUs). Results are printed as one JSON object per line.
+ *
+ * The build has no serial merge: every thread inserts straight into the shared table. To show where the time goes,
+ * the same chunks are also scanned on the same number of threads without touching a table. `scan_ms` is that pass,
+ * and `insert_ms` is the rest of the build, spent hashing keys into the table.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kv_index_parallel.h"
+#include "kv_scan.h"
+#include <assert.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+static double now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+/* One chunk scanned without indexing */
+typedef struct
+{
+    const char *str;
+    size_t len;
+    size_t keys;
+} scan_chunk;
+
+static void *scan_chunk_run(void *arg)
+{
+    scan_chunk *chunk = arg;
+    const char *end = chunk->str + chunk->len;
+    for (const char *line = chunk->str; line < end;)
+    {
+        kv_pair pair;
+        line = kv_scan_pair(line, end, &pair);
+        chunk->keys += pair.key != NULL;
+    }
+    return NULL;
+}
+
+/* Scans the buffer split at newline boundaries the way kv_index_build_parallel() splits it. Returns the elapsed time. */
+static double scan_parallel(const char *str, size_t len, unsigned int threads)
+{
+    scan_chunk chunks[threads];
+    pthread_t workers[threads];
+    const char *start = str;
+    const char *end = str + len;
+    for (unsigned int t = 0; t < threads; t++)
+    {
+        const char *split = t + 1 == threads ? end : str + len / threads * (t + 1);
+        if (split < start)
+        {
+            split = start;
+        }
+        if (split < end)
+        {
+            const char *eol = memchr(split, '\n', end - split);
+            split = eol ? eol + 1 : end;
+        }
+        chunks[t].str = start;
+        chunks[t].len = split - start;
+        chunks[t].keys = 0;
+        start = split;
+    }
+
+    const double begin = now_ns();
+    for (unsigned int t = 1; t < threads; t++)
+    {
+        if (pthread_create(&workers[t], NULL, scan_chunk_run, &chunks[t]) != 0)
+        {
+            fprintf(stderr, "pthread_create() failed\n");
+            exit(1);
+        }
+    }
+    scan_chunk_run(&chunks[0]);
+    for (unsigned int t = 1; t < threads; t++)
+    {
+        pthread_join(workers[t], NULL);
+    }
+    return now_ns() - begin;
+}
+
+int main(int argc, char *argv[])
+{
+    size_t size = argc > 1 ? strtoul(argv[1], NULL, 0) : 256UL * 1024UL * 1024UL;
+    long cpus = argc > 2 ? strtol(argv[2], NULL, 0) : sysconf(_SC_NPROCESSORS_ONLN);
+    if (cpus < 1)
+    {
+        cpus = 1;
+    }
+
+    /* Keys repeat so the merge has duplicates to resolve */
+    char *buf = malloc(size + 1);
+    assert(buf != NULL);
+    size_t pos = 0;
+    for (unsigned long line = 0;; line++)
+    {
+        char text[64];
+        int len = sprintf(text, "FLAG_%lu=enabled_%lu\n", line % 1000000UL, line);
+        if (pos + len > size)
+        {
+            break;
+        }
+        memcpy(buf + pos, text, len);
+        pos += len;
+    }
+    buf[pos] = '\0';
+
+    const size_t slot_count = kv_index_slot_count_n(buf, pos);
+    kv_index_entry *slots = malloc(slot_count * sizeof(*slots));
+    assert(slots != NULL);
+
+    double single_ns = 0;
+    for (long threads = 1; threads <= cpus; threads++)
+    {
+        kv_index index;
+        const double start = now_ns();
+        const int ret = kv_index_build_parallel(&index, buf, pos, slots, slot_count, (unsigned int)threads);
+        const double elapsed = now_ns() - start;
+        if (ret != 0)
+        {
+            fprintf(stderr, "kv_index_build_parallel() failed with %ld threads\n", threads);
+            return 1;
+        }
+        if (threads == 1)
+        {
+            single_ns = elapsed;
+        }
+
+        const double scan = scan_parallel(buf, pos, (unsigned int)threads);
+
+        printf("{\"func\":\"kv_index_build_parallel\",\"bytes\":%lu,\"threads\":%ld,\"keys\":%lu,\"ms\":%.1f,\"scan_ms\":%.1f,\"insert_ms\":%.1f,\"gb_per_s\":%.3f,\"speedup\":%.2f}\n",
+               (unsigned long)pos,
+               threads,
+               (unsigned long)index.count,
+               elapsed / 1e6,
+               scan / 1e6,
+               (elapsed > scan ? elapsed - scan : 0) / 1e6,
+               pos / elapsed,
+               single_ns / elapsed);
+        fflush(stdout);
+    }
+
+    free(slots);
+    free(buf);
+    return 0;
+}
@@ -0,0 +1,167 @@
+/**
+ * @file kv_bulk.c
+ * @brief Parallel key lookups across many small key-value files.
+ *
+ * This file contains a function that reads a list of formatted key-value files (e.g., "key=value" or "key: value")
+ * on a pool of worker threads and resolves the same set of keys in each, so that the time spent waiting on
+ * open and read calls overlaps instead of adding up file by file.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kv_bulk.h"
+#include "kv_get_value.h"
+#include <fcntl.h>
+#include <pthread.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Work shared by every thread */
+typedef struct
+{
+    const char *const *paths;
+    size_t npaths;
+    const char *const *keys;
+    unsigned int nkeys;
+    char *values;
+    unsigned int value_max;
+    unsigned int *value_lens;
+    int *status;
+    size_t next;
+    size_t loaded;
+} kv_bulk_job;
+
+/* Reads a whole file into `*buf`, growing it as needed, and NUL terminates it */
+static int kv_bulk_read(const char *path, char **buf, size_t *buf_size)
+{
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode))
+    {
+        close(fd);
+        return -1;
+    }
+
+    const size_t size = (size_t)st.st_size;
+    if (size + 1 > *buf_size)
+    {
+        char *grown = realloc(*buf, size + 1);
+        if (grown == NULL)
+        {
+            close(fd);
+            return -1;
+        }
+        *buf = grown;
+        *buf_size = size + 1;
+    }
+
+    size_t len = 0;
+    while (len < size)
+    {
+        const ssize_t n = pread(fd, *buf + len, size - len, (off_t)len);
+        if (n < 0)
+        {
+            close(fd);
+            return -1;
+        }
+        if (n == 0)
+        {
+            /* File shrank since fstat() */
+            break;
+        }
+        len += (size_t)n;
+    }
+    close(fd);
+
+    (*buf)[len] = '\0';
+    return 0;
+}
+
+static void *kv_bulk_worker(void *arg)
+{
+    kv_bulk_job *job = arg;
+    char *buf = NULL;
+    size_t buf_size = 0;
+
+    /* Output buffers of one batch of keys. Fixed size, as worker thread stacks are small. */
+    char *bufs[KV_GET_VALUES_BATCH];
+    unsigned int maxes[KV_GET_VALUES_BATCH];
+    for (unsigned int k = 0; k < KV_GET_VALUES_BATCH; k++)
+    {
+        maxes[k] = job->value_max;
+    }
+
+    for (size_t p = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED); p < job->npaths; p = __atomic_fetch_add(&job->next, 1, __ATOMIC_RELAXED))
+    {
+        unsigned int *lens = job->value_lens + p * job->nkeys;
+        for (unsigned int k = 0; k < job->nkeys; k++)
+        {
+            lens[k] = 0;
+            if (job->value_max > 0)
+            {
+                job->values[(p * job->nkeys + k) * job->value_max] = '\0';
+            }
+        }
+
+        job->status[p] = kv_bulk_read(job->paths[p], &buf, &buf_size);
+        if (job->status[p] != 0)
+        {
+            continue;
+        }
+        __atomic_fetch_add(&job->loaded, 1, __ATOMIC_RELAXED);
+
+        for (unsigned int first = 0; first < job->nkeys && job->value_max > 0; first += KV_GET_VALUES_BATCH)
+        {
+            const unsigned int batch = job->nkeys - first < KV_GET_VALUES_BATCH ? job->nkeys - first : KV_GET_VALUES_BATCH;
+            for (unsigned int k = 0; k < batch; k++)
+            {
+                bufs[k] = job->values + (p * job->nkeys + first + k) * job->value_max;
+            }
+            kv_get_values(buf, job->keys + first, batch, bufs, maxes, lens + first);
+        }
+    }
+
+    free(buf);
+    return NULL;
+}
+
+size_t kv_bulk_get_values(const char *const paths[], size_t npaths, const char *const keys[], unsigned int nkeys, char *values, unsigned int value_max, unsigned int value_lens[], int status[], unsigned int threads)
+{
+    kv_bulk_job job = {paths, npaths, keys, nkeys, values, value_max, value_lens, status, 0, 0};
+
+    if (threads == 0)
+    {
+        threads = KV_BULK_DEFAULT_THREADS;
+    }
+    if (threads > npaths)
+    {
+        threads = npaths > 0 ? (unsigned int)npaths : 1;
+    }
+
+    /* The calling thread is one of the workers */
+    pthread_t *workers = threads > 1 ? calloc(threads - 1, sizeof(*workers)) : NULL;
+    unsigned int started = 0;
+    for (; workers != NULL && started < threads - 1; started++)
+    {
+        if (pthread_create(&workers[started], NULL, kv_bulk_worker, &job) != 0)
+        {
+            break;
+        }
+    }
+    kv_bulk_worker(&job);
+    for (unsigned int t = 0; t < started; t++)
+    {
+        pthread_join(workers[t], NULL);
+    }
+    free(workers);
+
+    return job.loaded;
+}
@@ -0,0 +1,55 @@
+/**
+ * @file kv_bulk.h
+ * @brief Parallel key lookups across many small key-value files.
+ *
+ * This file contains a function that reads a list of formatted key-value files (e.g., "key=value" or "key: value")
+ * on a pool of worker threads and resolves the same set of keys in each, so that the time spent waiting on
+ * open and read calls overlaps instead of adding up file by file.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_bulk_H
+#define kv_bulk_H
+#include <stddef.h>
+
+/** Worker threads used when `kv_bulk_get_values()` is given `0` threads. Reads are I/O bound, so this may exceed the core count. */
+#ifndef KV_BULK_DEFAULT_THREADS
+#define KV_BULK_DEFAULT_THREADS 8
+#endif
+
+/**
+ * @brief Resolves a set of keys in each of many files, reading the files in parallel.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Each worker takes the next unread path, reads the whole file with `pread()` and resolves every key with
+ * `kv_get_values()`, so each file follows the same rules as `kv_get_value()`. The calling thread works too,
+ * and carries on alone if no thread can be started.
+ *
+ * Results for file `p` and key `k` are stored at index `p * nkeys + k`: the value in `values + (p * nkeys + k) * value_max`
+ * and its length in `value_lens`.
+ *
+ * @param paths Paths of the files to read.
+ * @param npaths Number of entries in `paths` and `status`.
+ * @param keys The keys to search for in every file.
+ * @param nkeys Number of entries in `keys`.
+ * @param values Output buffers, `npaths * nkeys * value_max` bytes.
+ * @param value_max Size of each value buffer, including the null terminator.
+ * @param value_lens Output value lengths, `npaths * nkeys` entries. `0` if the key is not found.
+ * @param status Output per file status: `0` if the file was read, or `-1` if it could not be.
+ * @param threads Number of threads, including the calling thread, or `0` for `KV_BULK_DEFAULT_THREADS`.
+ * @return The number of files read.
+ *
+ * @example Usage Example:
+ * @code
+ * const char *paths[] = {"/etc/app/a.env", "/etc/app/b.env"};
+ * const char *keys[] = {"PORT", "HOST"};
+ * char values[2 * 2 * 64];
+ * unsigned int lens[2 * 2];
+ * int status[2];
+ * kv_bulk_get_values(paths, 2, keys, 2, values, 64, lens, status, 0);
+ * printf("b.env HOST=%s\n", values + (1 * 2 + 1) * 64);
+ * @endcode
+ */
+size_t kv_bulk_get_values(const char *const paths[], size_t npaths, const char *const keys[], unsigned int nkeys, char *values, unsigned int value_max, unsigned int value_lens[], int status[], unsigned int threads);
+#endif
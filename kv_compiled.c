@@ -0,0 +1,332 @@
+/**
+ * @file kv_compiled.c
+ * @brief Precompiled binary key-value images for instant startup.
+ *
+ * This file contains functions that compile a formatted key-value file (e.g., "key=value" or "key: value") into a
+ * binary image holding a hash table and NUL terminated values, and that serve lookups from a memory mapped image
+ * with no parsing and no allocation. Stale or corrupted images fall back to parsing the text file.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kv_compiled.h"
+#include "kv_index.h"
+#include "kv_scan.h"
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Parse options this translation unit was built with. Images only load with matching options. */
+#ifdef KV_PARSE_DISABLE_WHITESPACE_SKIP
+#define KV_COMPILED_WHITESPACE_FLAG KV_COMPILED_NO_WHITESPACE_SKIP
+#else
+#define KV_COMPILED_WHITESPACE_FLAG 0u
+#endif
+#ifdef KV_PARSE_DISABLE_QUOTED_STRINGS
+#define KV_COMPILED_QUOTED_FLAG KV_COMPILED_NO_QUOTED_STRINGS
+#else
+#define KV_COMPILED_QUOTED_FLAG 0u
+#endif
+#define KV_COMPILED_PARSE_FLAGS (KV_COMPILED_WHITESPACE_FLAG | KV_COMPILED_QUOTED_FLAG)
+
+/* Key hash stored in the image (FNV-1a 32 bit). Part of the format. */
+static uint32_t kv_compiled_hash(const char *key, size_t key_len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < key_len; i++)
+    {
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+/* Image checksum (FNV-1a 64 bit) */
+static uint64_t kv_compiled_checksum(const unsigned char *data, size_t len)
+{
+    uint64_t hash = 14695981039346656037u;
+    for (size_t i = 0; i < len; i++)
+    {
+        hash ^= data[i];
+        hash *= 1099511628211u;
+    }
+    return hash;
+}
+
+/* Writes the image to a temporary file in the same directory and renames it over `image_path`, so readers never map a partial image */
+static int kv_compiled_write(const char *image_path, const unsigned char *image, size_t size)
+{
+    char tmp_path[strlen(image_path) + sizeof(".XXXXXX")];
+    strcpy(tmp_path, image_path);
+    strcat(tmp_path, ".XXXXXX");
+    const int fd = mkstemp(tmp_path);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    FILE *out = fchmod(fd, 0644) == 0 ? fdopen(fd, "wb") : NULL;
+    if (out == NULL)
+    {
+        close(fd);
+        unlink(tmp_path);
+        return -1;
+    }
+
+    int failed = fwrite(image, 1, size, out) != size;
+    failed |= fflush(out) != 0 || fsync(fd) != 0;
+    failed |= fclose(out) != 0;
+    if (failed || rename(tmp_path, image_path) != 0)
+    {
+        unlink(tmp_path);
+        return -1;
+    }
+    return 0;
+}
+
+int kv_compile_path(const char *text_path, const char *image_path)
+{
+    /* Record the metadata of the descriptor that is mapped, not of whatever the path names later */
+    struct stat st;
+    kv_mapped_file text;
+    const int fd = open(text_path, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    const int opened = fstat(fd, &st) == 0 && kv_mapped_file_open_fd(&text, fd) == 0;
+    close(fd);
+    if (!opened)
+    {
+        return -1;
+    }
+    const char *data = text.data ? text.data : "";
+
+    /* Parse once with the usual rules. First occurrence wins. */
+    kv_index index;
+    const size_t index_slot_count = kv_index_slot_count_n(data, text.size);
+    kv_index_entry *index_slots = malloc(index_slot_count * sizeof(*index_slots));
+    if (index_slots == NULL || kv_index_build_n(&index, data, text.size, index_slots, index_slot_count) != 0)
+    {
+        free(index_slots);
+        kv_mapped_file_close(&text);
+        return -1;
+    }
+
+    /* Lay out the image */
+    size_t strings_size = 0;
+    for (size_t i = 0; i < index.slot_count; i++)
+    {
+        if (index_slots[i].flags & KV_INDEX_SLOT_USED)
+        {
+            strings_size += index_slots[i].key_len + 1 + index_slots[i].value_len + 1;
+        }
+    }
+    size_t slot_count = 2;
+    while (slot_count < index.count * 2)
+    {
+        slot_count *= 2;
+    }
+    const size_t strings_offset = sizeof(kv_compiled_header) + slot_count * sizeof(kv_compiled_slot);
+    const size_t image_size = strings_offset + strings_size;
+
+    unsigned char *image = image_size <= UINT32_MAX ? calloc(1, image_size) : NULL;
+    if (image == NULL)
+    {
+        free(index_slots);
+        kv_mapped_file_close(&text);
+        return -1;
+    }
+
+    kv_compiled_header *header = (kv_compiled_header *)image;
+    kv_compiled_slot *slots = (kv_compiled_slot *)(image + sizeof(kv_compiled_header));
+    size_t pos = strings_offset;
+    for (size_t i = 0; i < index.slot_count; i++)
+    {
+        const kv_index_entry *entry = &index_slots[i];
+        if (!(entry->flags & KV_INDEX_SLOT_USED))
+        {
+            continue;
+        }
+
+        const uint32_t hash = kv_compiled_hash(data + entry->key_offset, entry->key_len);
+        size_t slot = hash & (slot_count - 1);
+        while (slots[slot].key_offset != 0)
+        {
+            slot = (slot + 1) & (slot_count - 1);
+        }
+
+        slots[slot].hash = hash;
+        slots[slot].key_offset = (uint32_t)pos;
+        memcpy(image + pos, data + entry->key_offset, entry->key_len);
+        pos += entry->key_len + 1;
+
+        slots[slot].value_offset = (uint32_t)pos;
+        slots[slot].value_len = kv_scan_unescape(data + entry->value_offset, entry->value_len, entry->flags & ~KV_INDEX_SLOT_USED, (char *)image + pos, entry->value_len + 1);
+        pos += slots[slot].value_len + 1;
+    }
+
+    memcpy(header->magic, "KVC", 4);
+    header->version = KV_COMPILED_VERSION;
+    header->parse_flags = KV_COMPILED_PARSE_FLAGS;
+    header->slot_count = (uint32_t)slot_count;
+    header->count = (uint32_t)index.count;
+    header->image_size = pos;
+    header->source_size = (uint64_t)st.st_size;
+    header->source_mtime = (int64_t)st.st_mtim.tv_sec;
+    header->source_mtime_nsec = (uint32_t)st.st_mtim.tv_nsec;
+    header->checksum = kv_compiled_checksum(image + sizeof(kv_compiled_header), pos - sizeof(kv_compiled_header));
+
+    free(index_slots);
+    kv_mapped_file_close(&text);
+
+    const int result = kv_compiled_write(image_path, image, pos);
+    free(image);
+    return result;
+}
+
+/* Returns 1 if the mapped image is intact, current and built with the same parse options */
+static int kv_compiled_valid(const kv_mapped_file *image, const char *text_path)
+{
+    if (image->size < sizeof(kv_compiled_header))
+    {
+        return 0;
+    }
+
+    const kv_compiled_header *header = (const kv_compiled_header *)image->data;
+    if (memcmp(header->magic, "KVC", 4) != 0 || header->version != KV_COMPILED_VERSION || header->parse_flags != KV_COMPILED_PARSE_FLAGS ||
+        header->image_size != image->size || header->slot_count == 0 || (header->slot_count & (header->slot_count - 1)) != 0 ||
+        sizeof(kv_compiled_header) + (uint64_t)header->slot_count * sizeof(kv_compiled_slot) > image->size)
+    {
+        return 0;
+    }
+
+    /* Strings must be NUL terminated within the image */
+    if (header->count > 0 && image->data[image->size - 1] != '\0')
+    {
+        return 0;
+    }
+
+    if (text_path != NULL)
+    {
+        struct stat st;
+        if (stat(text_path, &st) != 0 || header->source_size != (uint64_t)st.st_size || header->source_mtime != (int64_t)st.st_mtim.tv_sec ||
+            header->source_mtime_nsec != (uint32_t)st.st_mtim.tv_nsec)
+        {
+            /* Stale image */
+            return 0;
+        }
+    }
+
+    const unsigned char *data = (const unsigned char *)image->data;
+    if (header->checksum != kv_compiled_checksum(data + sizeof(kv_compiled_header), image->size - sizeof(kv_compiled_header)))
+    {
+        return 0;
+    }
+
+    /* A checksum does not stop a crafted image. Every offset must stay in the image, and one slot must stay empty so lookups end. */
+    const uint64_t strings_offset = sizeof(kv_compiled_header) + (uint64_t)header->slot_count * sizeof(kv_compiled_slot);
+    const kv_compiled_slot *slots = (const kv_compiled_slot *)(image->data + sizeof(kv_compiled_header));
+    uint32_t used = 0;
+    for (uint32_t i = 0; i < header->slot_count; i++)
+    {
+        if (slots[i].key_offset == 0)
+        {
+            continue;
+        }
+        if (slots[i].key_offset < strings_offset || slots[i].key_offset >= image->size || slots[i].value_offset < strings_offset ||
+            (uint64_t)slots[i].value_offset + slots[i].value_len >= image->size || image->data[slots[i].value_offset + slots[i].value_len] != '\0')
+        {
+            return 0;
+        }
+        used++;
+    }
+    return used == header->count && header->count < header->slot_count;
+}
+
+int kv_compiled_open(kv_compiled *compiled, const char *image_path, const char *text_path)
+{
+    memset(compiled, 0, sizeof(*compiled));
+
+    if (kv_mapped_file_open(&compiled->image, image_path) == 0)
+    {
+        if (kv_compiled_valid(&compiled->image, text_path))
+        {
+            compiled->header = (const kv_compiled_header *)compiled->image.data;
+            compiled->slots = (const kv_compiled_slot *)(compiled->image.data + sizeof(kv_compiled_header));
+            return 0;
+        }
+        kv_mapped_file_close(&compiled->image);
+    }
+
+    /* Fall back to parsing the text file */
+    if (text_path != NULL && kv_mapped_file_open(&compiled->text, text_path) == 0)
+    {
+        return 1;
+    }
+    return -1;
+}
+
+void kv_compiled_close(kv_compiled *compiled)
+{
+    kv_mapped_file_close(&compiled->image);
+    kv_mapped_file_close(&compiled->text);
+    compiled->header = NULL;
+    compiled->slots = NULL;
+}
+
+const char *kv_compiled_find(const kv_compiled *compiled, const char *key, size_t *value_len)
+{
+    if (compiled->header == NULL)
+    {
+        return NULL;
+    }
+
+    const uint32_t hash = kv_compiled_hash(key, strlen(key));
+    const uint32_t mask = compiled->header->slot_count - 1;
+    for (uint32_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        const kv_compiled_slot *entry = &compiled->slots[slot];
+        if (entry->key_offset == 0)
+        {
+            return NULL;
+        }
+
+        if (entry->hash == hash && strcmp(compiled->image.data + entry->key_offset, key) == 0)
+        {
+            if (value_len != NULL)
+            {
+                *value_len = entry->value_len;
+            }
+            return compiled->image.data + entry->value_offset;
+        }
+    }
+}
+
+unsigned int kv_compiled_get_value(const kv_compiled *compiled, const char *key, char *value, unsigned int value_max)
+{
+    if (compiled->header == NULL)
+    {
+        return kv_mapped_file_get_value(&compiled->text, key, value, value_max);
+    }
+
+    size_t len = 0;
+    const char *found = kv_compiled_find(compiled, key, &len);
+    if (found == NULL || len + 1 > value_max)
+    {
+        /* Not found, or value too large for buffer. Don't return a value. */
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    memcpy(value, found, len + 1);
+    return (unsigned int)len;
+}
@@ -0,0 +1,131 @@
+/**
+ * @file kv_compiled.h
+ * @brief Precompiled binary key-value images for instant startup.
+ *
+ * This file contains functions that compile a formatted key-value file (e.g., "key=value" or "key: value") into a
+ * binary image holding a hash table and NUL terminated values, and that serve lookups from a memory mapped image
+ * with no parsing and no allocation. Stale or corrupted images fall back to parsing the text file.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_compiled_H
+#define kv_compiled_H
+#include "kv_mapped_file.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/** Bump whenever the image layout changes */
+#define KV_COMPILED_VERSION 2u
+
+/** `parse_flags` bit: image compiled with `KV_PARSE_DISABLE_WHITESPACE_SKIP` */
+#define KV_COMPILED_NO_WHITESPACE_SKIP 0x01u
+/** `parse_flags` bit: image compiled with `KV_PARSE_DISABLE_QUOTED_STRINGS` */
+#define KV_COMPILED_NO_QUOTED_STRINGS 0x02u
+
+/**
+ * @brief Image header. All fields are in native byte order.
+ *
+ * Image layout: header, then `slot_count` slots, then each key and value as NUL terminated strings.
+ */
+typedef struct
+{
+    char magic[4];              /**< `"KVC"` followed by a NUL. */
+    uint32_t version;           /**< `KV_COMPILED_VERSION`. */
+    uint32_t parse_flags;       /**< `KV_COMPILED_NO_*` bits the compiler was built with. Must match the loader. */
+    uint32_t slot_count;        /**< Number of hash slots. A power of two. */
+    uint32_t count;             /**< Number of keys. */
+    uint32_t source_mtime_nsec; /**< Nanoseconds part of `source_mtime`, so edits within one second are noticed. */
+    uint64_t image_size;        /**< Total image size in bytes. */
+    uint64_t source_size;       /**< Size of the text file the image was compiled from. */
+    int64_t source_mtime;       /**< Modification time (seconds) of the text file the image was compiled from. */
+    uint64_t checksum;          /**< FNV-1a 64 bit hash of every byte after the header. */
+} kv_compiled_header;
+
+/**
+ * @brief One hash slot. An empty slot has `key_offset == 0`.
+ */
+typedef struct
+{
+    uint32_t hash;         /**< Hash of the key. */
+    uint32_t key_offset;   /**< Offset of the NUL terminated key from the start of the image. */
+    uint32_t value_offset; /**< Offset of the NUL terminated value from the start of the image. */
+    uint32_t value_len;    /**< Length of the value. */
+} kv_compiled_slot;
+
+/**
+ * @brief Loaded image, or the text file it falls back to.
+ */
+typedef struct
+{
+    kv_mapped_file image;            /**< Mapped image. Unused in fallback mode. */
+    kv_mapped_file text;             /**< Mapped text file. Only used in fallback mode. */
+    const kv_compiled_header *header; /**< Image header, or `NULL` in fallback mode. */
+    const kv_compiled_slot *slots;   /**< Image hash slots. */
+} kv_compiled;
+
+/**
+ * @brief Compiles a key-value text file into a binary image.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * The text is parsed with the exact rules of `kv_get_value()`: first occurrence wins and values are stored with
+ * quotes resolved. The image is written to a temporary file in the same directory and renamed over `image_path`,
+ * so a process mapping the old image keeps a complete copy.
+ *
+ * @param text_path Path of the key-value text file.
+ * @param image_path Path of the image to write.
+ * @return `0` on success, or `-1` on failure.
+ */
+int kv_compile_path(const char *text_path, const char *image_path);
+
+/**
+ * @brief Maps a compiled image, falling back to the text file if the image is unusable.
+ *
+ * The image is rejected if its magic, version, parse flags or checksum do not match, or if `text_path` is given and
+ * its size or modification time differ from those recorded at compile time. Lookups then parse the text file instead.
+ *
+ * @param compiled Handle to initialise.
+ * @param image_path Path of the compiled image.
+ * @param text_path Path of the source text file for the staleness check and fallback, or `NULL`.
+ * @return `0` if the image was loaded, `1` if falling back to the text file, or `-1` if neither could be opened.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_compiled compiled;
+ * char buffer[50];
+ * if (kv_compiled_open(&compiled, "app.kvc", "app.conf") >= 0) {
+ *     unsigned int len = kv_compiled_get_value(&compiled, "mode", buffer, sizeof(buffer));
+ *     kv_compiled_close(&compiled);
+ * }
+ * @endcode
+ */
+int kv_compiled_open(kv_compiled *compiled, const char *image_path, const char *text_path);
+
+/**
+ * @brief Unmaps an image or text file opened with `kv_compiled_open()`.
+ *
+ * @param compiled Handle to release.
+ */
+void kv_compiled_close(kv_compiled *compiled);
+
+/**
+ * @brief Finds a value in a compiled image without copying.
+ *
+ * @param compiled Handle opened with `kv_compiled_open()` that loaded the image (not in fallback mode).
+ * @param key The key to search for.
+ * @param value_len Output length of the value. May be `NULL`.
+ * @return The NUL terminated value inside the image, or `NULL` if the key is not found or no image is loaded.
+ */
+const char *kv_compiled_find(const kv_compiled *compiled, const char *key, size_t *value_len);
+
+/**
+ * @brief Gets a value from a compiled image, or from the text file in fallback mode.
+ *
+ * @param compiled Handle opened with `kv_compiled_open()`.
+ * @param key The key to search for.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_compiled_get_value(const kv_compiled *compiled, const char *key, char *value, unsigned int value_max);
+#endif
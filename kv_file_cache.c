@@ -0,0 +1,256 @@
+/**
+ * @file kv_file_cache.c
+ * @brief Cache of indexed key-value files, reloaded only when a file changes.
+ *
+ * This file contains functions that keep a parsed `kv_index` for each formatted key-value file (e.g., "key=value" or "key: value")
+ * and revalidate it cheaply with `stat()`, so frequent polling does not reread unchanged files.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kv_file_cache.h"
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
+
+int kv_file_cache_init(kv_file_cache *cache, unsigned int flags)
+{
+    cache->entries = NULL;
+    cache->count = 0;
+    cache->capacity = 0;
+    cache->inotify_fd = -1;
+
+#ifdef __linux__
+    if (flags & KV_FILE_CACHE_INOTIFY)
+    {
+        cache->inotify_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (cache->inotify_fd < 0)
+        {
+            return -1;
+        }
+    }
+#else
+    (void)flags;
+#endif
+
+    return 0;
+}
+
+/* Drops the file contents and index of an entry */
+static void kv_file_cache_unload(kv_file_cache_entry *entry)
+{
+    free(entry->data);
+    free(entry->slots);
+    entry->data = NULL;
+    entry->slots = NULL;
+}
+
+void kv_file_cache_free(kv_file_cache *cache)
+{
+    for (unsigned int i = 0; i < cache->count; i++)
+    {
+        kv_file_cache_unload(&cache->entries[i]);
+        free(cache->entries[i].path);
+    }
+    free(cache->entries);
+
+    if (cache->inotify_fd >= 0)
+    {
+        close(cache->inotify_fd);
+    }
+
+    cache->entries = NULL;
+    cache->count = 0;
+    cache->capacity = 0;
+    cache->inotify_fd = -1;
+}
+
+static int kv_file_cache_same_file(const kv_file_cache_entry *entry, const struct stat *st)
+{
+    return entry->dev == (unsigned long long)st->st_dev && entry->ino == (unsigned long long)st->st_ino && entry->size == (long long)st->st_size &&
+           entry->mtime_sec == (long long)st->st_mtim.tv_sec && entry->mtime_nsec == st->st_mtim.tv_nsec;
+}
+
+/* Reads and indexes the file. Returns 0 on success. */
+static int kv_file_cache_load(kv_file_cache *cache, kv_file_cache_entry *entry)
+{
+    kv_file_cache_unload(entry);
+
+#ifdef __linux__
+    if (cache->inotify_fd >= 0)
+    {
+        /* (Re)arm the watch first so a change made while reading is not missed. A replaced file gets a new watch. */
+        if (entry->watch >= 0)
+        {
+            inotify_rm_watch(cache->inotify_fd, entry->watch);
+        }
+        entry->watch = inotify_add_watch(cache->inotify_fd, entry->path, IN_MODIFY | IN_ATTRIB | IN_CLOSE_WRITE | IN_MOVE_SELF | IN_DELETE_SELF);
+    }
+#endif
+    entry->stale = 0;
+
+    const int fd = open(entry->path, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+
+    char *data = malloc((size_t)st.st_size + 1);
+    size_t len = 0;
+    while (data != NULL && len < (size_t)st.st_size)
+    {
+        ssize_t got = read(fd, data + len, (size_t)st.st_size - len);
+        if (got <= 0)
+        {
+            break;
+        }
+        len += (size_t)got;
+    }
+    close(fd);
+    if (data == NULL)
+    {
+        return -1;
+    }
+    data[len] = '\0';
+
+    const size_t slot_count = kv_index_slot_count(data);
+    kv_index_entry *slots = malloc(slot_count * sizeof(*slots));
+    if (slots == NULL || kv_index_build(&entry->index, data, slots, slot_count) != 0)
+    {
+        free(slots);
+        free(data);
+        return -1;
+    }
+
+    entry->data = data;
+    entry->slots = slots;
+    entry->dev = (unsigned long long)st.st_dev;
+    entry->ino = (unsigned long long)st.st_ino;
+    entry->size = (long long)st.st_size;
+    entry->mtime_sec = (long long)st.st_mtim.tv_sec;
+    entry->mtime_nsec = st.st_mtim.tv_nsec;
+    return 0;
+}
+
+#ifdef __linux__
+/* Marks entries reported by inotify as stale */
+static void kv_file_cache_drain_events(kv_file_cache *cache)
+{
+    char events[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    ssize_t len;
+    while ((len = read(cache->inotify_fd, events, sizeof(events))) > 0)
+    {
+        for (char *pos = events; pos < events + len;)
+        {
+            const struct inotify_event *event = (const struct inotify_event *)pos;
+            for (unsigned int i = 0; i < cache->count; i++)
+            {
+                if (cache->entries[i].watch == event->wd)
+                {
+                    cache->entries[i].stale = 1;
+                }
+            }
+            pos += sizeof(struct inotify_event) + event->len;
+        }
+    }
+}
+#endif
+
+const kv_index *kv_file_cache_get(kv_file_cache *cache, const char *path)
+{
+    kv_file_cache_entry *entry = NULL;
+    for (unsigned int i = 0; i < cache->count; i++)
+    {
+        if (strcmp(cache->entries[i].path, path) == 0)
+        {
+            entry = &cache->entries[i];
+            break;
+        }
+    }
+
+    if (entry == NULL)
+    {
+        /* New file. Add an entry. */
+        if (cache->count == cache->capacity)
+        {
+            const unsigned int capacity = cache->capacity ? cache->capacity * 2 : 4;
+            kv_file_cache_entry *entries = realloc(cache->entries, capacity * sizeof(*entries));
+            if (entries == NULL)
+            {
+                return NULL;
+            }
+            cache->entries = entries;
+            cache->capacity = capacity;
+        }
+
+        char *path_copy = malloc(strlen(path) + 1);
+        if (path_copy == NULL)
+        {
+            return NULL;
+        }
+        strcpy(path_copy, path);
+
+        entry = &cache->entries[cache->count++];
+        memset(entry, 0, sizeof(*entry));
+        entry->path = path_copy;
+        entry->watch = -1;
+        kv_file_cache_load(cache, entry);
+        return entry->data ? &entry->index : NULL;
+    }
+
+#ifdef __linux__
+    if (cache->inotify_fd >= 0)
+    {
+        kv_file_cache_drain_events(cache);
+        if (!entry->stale && entry->data != NULL)
+        {
+            return &entry->index;
+        }
+        kv_file_cache_load(cache, entry);
+        return entry->data ? &entry->index : NULL;
+    }
+#endif
+
+    /* Revalidate with stat() */
+    struct stat st;
+    if (stat(path, &st) != 0)
+    {
+        kv_file_cache_unload(entry);
+        return NULL;
+    }
+
+    if (entry->data == NULL || !kv_file_cache_same_file(entry, &st))
+    {
+        kv_file_cache_load(cache, entry);
+    }
+    return entry->data ? &entry->index : NULL;
+}
+
+unsigned int kv_file_cache_get_value(kv_file_cache *cache, const char *path, const char *key, char *value, unsigned int value_max)
+{
+    const kv_index *index = kv_file_cache_get(cache, path);
+    if (index == NULL)
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    return kv_index_get_value(index, key, value, value_max);
+}
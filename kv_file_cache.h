@@ -0,0 +1,95 @@
+/**
+ * @file kv_file_cache.h
+ * @brief Cache of indexed key-value files, reloaded only when a file changes.
+ *
+ * This file contains functions that keep a parsed `kv_index` for each formatted key-value file (e.g., "key=value" or "key: value")
+ * and revalidate it cheaply with `stat()`, so frequent polling does not reread unchanged files.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_file_cache_H
+#define kv_file_cache_H
+#include "kv_index.h"
+
+/** Use inotify (Linux only) to learn about changes, so unchanged files are not even `stat()`ed. Ignored elsewhere. */
+#define KV_FILE_CACHE_INOTIFY 0x01u
+
+/**
+ * @brief One cached file.
+ */
+typedef struct
+{
+    char *path;                 /**< Path of the file. */
+    char *data;                 /**< NUL terminated file contents, or `NULL` if the file could not be read. */
+    kv_index_entry *slots;      /**< Index slot table. */
+    kv_index index;             /**< Index over `data`. */
+    unsigned long long dev;     /**< Device of the file when it was read. */
+    unsigned long long ino;     /**< Inode of the file when it was read. */
+    long long size;             /**< Size of the file when it was read. */
+    long long mtime_sec;        /**< Modification time of the file when it was read (seconds). */
+    long mtime_nsec;            /**< Modification time of the file when it was read (nanoseconds). */
+    int watch;                  /**< inotify watch descriptor, or `-1`. */
+    int stale;                  /**< Set when inotify reported a change. */
+} kv_file_cache_entry;
+
+/**
+ * @brief Cache of indexed key-value files.
+ */
+typedef struct
+{
+    kv_file_cache_entry *entries; /**< Cached files. */
+    unsigned int count;           /**< Number of cached files. */
+    unsigned int capacity;        /**< Allocated entries. */
+    int inotify_fd;               /**< inotify instance, or `-1` when revalidating with `stat()`. */
+} kv_file_cache;
+
+/**
+ * @brief Initialises an empty file cache.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * @param cache Cache to initialise.
+ * @param flags `0`, or `KV_FILE_CACHE_INOTIFY`.
+ * @return `0` on success, or `-1` if inotify was requested but could not be set up.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_file_cache cache;
+ * char buffer[50];
+ * kv_file_cache_init(&cache, 0);
+ * unsigned int len = kv_file_cache_get_value(&cache, "/etc/myapp.conf", "mode", buffer, sizeof(buffer));
+ * kv_file_cache_free(&cache);
+ * @endcode
+ */
+int kv_file_cache_init(kv_file_cache *cache, unsigned int flags);
+
+/**
+ * @brief Frees every cached file.
+ *
+ * @param cache Cache initialised with `kv_file_cache_init()`.
+ */
+void kv_file_cache_free(kv_file_cache *cache);
+
+/**
+ * @brief Gets the up to date index for a file, reading and indexing it only if it is new or has changed.
+ *
+ * A file counts as changed when its device, inode, size or modification time differ from when it was read.
+ *
+ * @param cache Cache initialised with `kv_file_cache_init()`.
+ * @param path Path of the key-value file.
+ * @return The file's index, or `NULL` if the file cannot be read. Valid until the next call on this cache.
+ */
+const kv_index *kv_file_cache_get(kv_file_cache *cache, const char *path);
+
+/**
+ * @brief Parses a key-value pair from a cached file.
+ *
+ * @param cache Cache initialised with `kv_file_cache_init()`.
+ * @param path Path of the key-value file.
+ * @param key The key to search for in the file.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found, does not fit or the file cannot be read.
+ */
+unsigned int kv_file_cache_get_value(kv_file_cache *cache, const char *path, const char *key, char *value, unsigned int value_max);
+#endif
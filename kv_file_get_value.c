@@ -8,7 +8,22 @@
  * This code is released to the public domain by Brian Khuu in 2025.
  */
 
+#include "kv_file_get_value.h"
 #include <stdio.h>
+#include <string.h>
+
+#ifdef KV_PARSE_STATS
+#include "kv_stats.h"
+
+/* Bytes read since the rewind() at the start of the lookup */
+static unsigned long long kv_stats_file_pos(FILE *file)
+{
+    const long pos = ftell(file);
+    return pos > 0 ? (unsigned long long)pos : 0;
+}
+#else
+#define KV_STATS_ADD(field, n) ((void)0)
+#endif
 
 unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigned int value_max)
 {
@@ -24,11 +39,17 @@ unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigne
 #endif
 
         /* Check For Key */
+#ifdef KV_PARSE_STATS
+        int stats_matched = 0;
+#endif
         for (int i = 0; ch != EOF && key[i] != '\0'; i++, ch = getc(file))
         {
             /* Key Mismatched. Skip Line */
             if (ch != key[i])
             {
+#ifdef KV_PARSE_STATS
+                stats_matched = i;
+#endif
                 goto skip_line;
             }
         }
@@ -43,6 +64,9 @@ unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigne
         /* Check For Key Value Delimiter */
         if (ch != '=' && ch != ':')
         {
+            KV_STATS_ADD(bytes_scanned, kv_stats_file_pos(file));
+            KV_STATS_ADD(partial_matches, 1);
+            KV_STATS_ADD(misses, 1);
             return 0;
         }
         ch = getc(file);
@@ -72,6 +96,8 @@ unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigne
                     value[i] = '\0';
                 }
 #endif
+                KV_STATS_ADD(bytes_scanned, kv_stats_file_pos(file));
+                KV_STATS_ADD(hits, 1);
                 return i;
             }
 #ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
@@ -85,6 +111,8 @@ unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigne
             {
                 /* End Of Quoted String. Return Value */
                 value[i] = '\0';
+                KV_STATS_ADD(bytes_scanned, kv_stats_file_pos(file));
+                KV_STATS_ADD(hits, 1);
                 return i;
             }
             else if (quote != EOF && prev == '\\' && ch == quote)
@@ -102,15 +130,22 @@ unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigne
 
         /* Value too large for buffer. Don't return a value. */
         value[0] = '\0';
+        KV_STATS_ADD(bytes_scanned, kv_stats_file_pos(file));
+        KV_STATS_ADD(truncated, 1);
         return 0;
 
     skip_line:
+        KV_STATS_ADD(lines_skipped, 1);
+        KV_STATS_ADD(partial_matches, stats_matched > 0);
+
         /* Search for start of next line */
         while (ch != '\n')
         {
             if (ch == EOF)
             {
                 /* End of string. Key was not found. */
+                KV_STATS_ADD(bytes_scanned, kv_stats_file_pos(file));
+                KV_STATS_ADD(misses, 1);
                 return 0;
             }
             ch = getc(file);
@@ -118,5 +153,242 @@ unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigne
     }
 
     /* End of string. Key was not found. */
+    KV_STATS_ADD(bytes_scanned, kv_stats_file_pos(file));
+    KV_STATS_ADD(misses, 1);
     return 0;
 }
+
+/* Value being copied out of the stream. Several keys on one line (e.g. "a=b=1" holds "a" and "a=b") are copied side by side. */
+typedef struct
+{
+    unsigned int key;
+    char *value;
+    unsigned int value_max;
+    unsigned int len;
+    int started;
+    int done;
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    int quote;
+    int prev;
+#endif
+} kv_file_values_copy;
+
+/* Feeds the next character of a value, using the same rules as kv_file_get_value() */
+static void kv_file_values_feed(kv_file_values_copy *copy, int ch)
+{
+    if (copy->done)
+    {
+        return;
+    }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    if (!copy->started && (ch == ' ' || ch == '\t'))
+    {
+        /* Whitespace after the delimiter */
+        return;
+    }
+#endif
+    copy->started = 1;
+
+    if (ch == EOF || ch == '\r' || ch == '\n')
+    {
+        /* End Of Line. Trim trailing whitespace. */
+        copy->value[copy->len] = '\0';
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (copy->len > 0 && (copy->value[copy->len - 1] == ' ' || copy->value[copy->len - 1] == '\t'))
+        {
+            copy->len--;
+            copy->value[copy->len] = '\0';
+        }
+#endif
+        copy->done = 1;
+        return;
+    }
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    if (copy->quote == EOF && (ch == '\'' || ch == '"'))
+    {
+        /* Start Of Quoted String */
+        copy->quote = ch;
+        copy->prev = ch;
+        return;
+    }
+    else if (copy->quote != EOF && copy->prev != '\\' && ch == copy->quote)
+    {
+        /* End Of Quoted String */
+        copy->value[copy->len] = '\0';
+        copy->done = 1;
+        return;
+    }
+    else if (copy->quote != EOF && copy->prev == '\\' && ch == copy->quote)
+    {
+        /* Escaped Character In Quoted String */
+        copy->value[copy->len - 1] = ch;
+        copy->prev = ch;
+        return;
+    }
+    copy->prev = ch;
+#endif
+
+    if (copy->len + 1 >= copy->value_max)
+    {
+        /* Value too large for buffer. Don't return a value. */
+        copy->value[0] = '\0';
+        copy->len = 0;
+        copy->done = 1;
+        return;
+    }
+    copy->value[copy->len++] = ch;
+}
+
+/* Matches `key` at the start of a buffered line the way kv_get_value() does. Returns the offset just past the delimiter, or 0 if the line does not hold the key. */
+static size_t kv_file_values_match(const char *line, size_t line_len, const char *key)
+{
+    size_t i = 0;
+    while (key[i] != '\0' && i < line_len && line[i] == key[i])
+    {
+        i++;
+    }
+    if (key[i] != '\0')
+    {
+        return 0;
+    }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (i < line_len && (line[i] == ' ' || line[i] == '\t'))
+    {
+        i++;
+    }
+#endif
+
+    /* Check For Key Value Delimiter */
+    if (i >= line_len || (line[i] != '=' && line[i] != ':'))
+    {
+        return 0;
+    }
+    return i + 1;
+}
+
+/* Resolves up to KV_FILE_GET_VALUES_BATCH keys in one read through the file */
+static unsigned int kv_file_get_values_batch(FILE *file, const char *const keys[], unsigned int nkeys, char *const out_bufs[], const unsigned int out_max[], unsigned int out_lens[])
+{
+    /* Keys resolved so far. First occurrence wins. */
+    unsigned char resolved[KV_FILE_GET_VALUES_BATCH];
+    kv_file_values_copy copies[KV_FILE_GET_VALUES_BATCH];
+    for (unsigned int k = 0; k < nkeys; k++)
+    {
+        resolved[k] = 0;
+        out_lens[k] = 0;
+        if (out_max[k] > 0)
+        {
+            out_bufs[k][0] = '\0';
+        }
+    }
+
+    /* Start of the current line. Keys must lie within it. */
+    char line[KV_FILE_GET_VALUES_LINE_MAX];
+
+    rewind(file);
+
+    unsigned int found = 0;
+    unsigned int remaining = nkeys;
+    for (int ch = getc(file); ch != EOF && remaining > 0; ch = getc(file))
+    {
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Buffer The Start Of The Line */
+        size_t line_len = 0;
+        for (; line_len < sizeof(line) && ch != EOF && ch != '\n'; ch = getc(file))
+        {
+            line[line_len++] = ch;
+        }
+
+        /* Check Every Unresolved Key Against This Line */
+        unsigned int copying = 0;
+        for (unsigned int k = 0; k < nkeys; k++)
+        {
+            const size_t value = resolved[k] ? 0 : kv_file_values_match(line, line_len, keys[k]);
+            if (value == 0)
+            {
+                continue;
+            }
+
+            resolved[k] = 1;
+            remaining--;
+            if (out_max[k] == 0)
+            {
+                continue;
+            }
+
+            kv_file_values_copy *copy = &copies[copying++];
+            memset(copy, 0, sizeof(*copy));
+            copy->key = k;
+            copy->value = out_bufs[k];
+            copy->value_max = out_max[k];
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+            copy->quote = EOF;
+            copy->prev = EOF;
+#endif
+            for (size_t i = value; i < line_len && !copy->done; i++)
+            {
+                kv_file_values_feed(copy, (unsigned char)line[i]);
+            }
+        }
+
+        /* Copy The Rest Of The Line Into Every Unfinished Value */
+        int active = 0;
+        for (unsigned int c = 0; c < copying; c++)
+        {
+            active |= !copies[c].done;
+        }
+        while (active)
+        {
+            active = 0;
+            for (unsigned int c = 0; c < copying; c++)
+            {
+                kv_file_values_feed(&copies[c], ch);
+                active |= !copies[c].done;
+            }
+            if (active)
+            {
+                ch = getc(file);
+            }
+        }
+
+        for (unsigned int c = 0; c < copying; c++)
+        {
+            out_lens[copies[c].key] = copies[c].len;
+            found += copies[c].len > 0;
+        }
+
+        /* Search for start of next line */
+        while (ch != '\n')
+        {
+            if (ch == EOF)
+            {
+                /* End of file. */
+                return found;
+            }
+            ch = getc(file);
+        }
+    }
+
+    return found;
+}
+
+unsigned int kv_file_get_values(FILE *file, const char *const keys[], unsigned int nkeys, char *const out_bufs[], const unsigned int out_max[], unsigned int out_lens[])
+{
+    /* Fixed size state per batch, so the stack use does not depend on nkeys */
+    unsigned int found = 0;
+    for (unsigned int first = 0; first < nkeys; first += KV_FILE_GET_VALUES_BATCH)
+    {
+        const unsigned int batch = nkeys - first < KV_FILE_GET_VALUES_BATCH ? nkeys - first : KV_FILE_GET_VALUES_BATCH;
+        found += kv_file_get_values_batch(file, keys + first, batch, out_bufs + first, out_max + first, out_lens + first);
+    }
+    return found;
+}
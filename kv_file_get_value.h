@@ -10,6 +10,16 @@
 #ifndef kv_file_get_value_H
 #define kv_file_get_value_H
 #include <stdio.h>
+
+/** Keys `kv_file_get_values()` resolves per read through the file. More keys take more reads, keeping stack use fixed. */
+#ifndef KV_FILE_GET_VALUES_BATCH
+#define KV_FILE_GET_VALUES_BATCH 32
+#endif
+
+/** Bytes at the start of each line `kv_file_get_values()` buffers. A key and its delimiter must lie within them. */
+#ifndef KV_FILE_GET_VALUES_LINE_MAX
+#define KV_FILE_GET_VALUES_LINE_MAX 256
+#endif
 /**
  * @brief Parses a key-value pair from a given file.
  *
@@ -47,4 +57,26 @@
  * @endcode
  */
 unsigned int kv_file_get_value(FILE *file, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Parses several key-value pairs from a given file in a single pass.
+ *
+ * This function resolves a whole set of keys with one `rewind()` and one read through the file (one per
+ * `KV_FILE_GET_VALUES_BATCH` keys), instead of calling `kv_file_get_value()` once per key. Each key is
+ * matched as a prefix of the line exactly as `kv_get_value()` does, including first occurrence wins, so a
+ * line such as `"a=b=1"` resolves both `"a"` and `"a=b"`. Reading stops once every key is resolved.
+ *
+ * Unlike `kv_file_get_value()`, a line that starts with the key but has no delimiter after it is skipped.
+ * Only the first `KV_FILE_GET_VALUES_LINE_MAX` bytes of a line are buffered, so a key whose delimiter lies
+ * beyond them is not found there. Values may be any length.
+ *
+ * @param file Input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @param keys The keys to search for in the input file.
+ * @param nkeys Number of entries in `keys`, `out_bufs`, `out_max` and `out_lens`.
+ * @param out_bufs Output buffers to store each extracted value.
+ * @param out_max Maximum length of each output buffer, including the null terminator.
+ * @param out_lens Length of each extracted value (excluding the null terminator), or `0` if the key is not found.
+ * @return The number of keys with a value found.
+ */
+unsigned int kv_file_get_values(FILE *file, const char *const keys[], unsigned int nkeys, char *const out_bufs[], const unsigned int out_max[], unsigned int out_lens[]);
 #endif
@@ -0,0 +1,49 @@
+/**
+ * @file kv_foreach.c
+ * @brief Enumerates every key-value pair in one pass.
+ *
+ * This file contains functions that walk a formatted key-value string or file (e.g., "key=value" or "key: value")
+ * once and pass each well formed pair to a callback.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_foreach.h"
+#include "kv_stream.h"
+
+int kv_foreach(const char *str, kv_foreach_cb cb, void *ctx)
+{
+    while (*str != '\0')
+    {
+        kv_pair pair;
+        str = kv_scan_pair(str, NULL, &pair);
+        if (pair.key != NULL && cb(ctx, &pair) != 0)
+        {
+            return 1;
+        }
+    }
+
+    return 0;
+}
+
+int kv_file_foreach(FILE *file, kv_foreach_cb cb, void *ctx)
+{
+    char key[KV_FILE_FOREACH_KEY_MAX];
+    char value[KV_FILE_FOREACH_VALUE_MAX];
+    char chunk[4096];
+    kv_stream stream;
+    kv_stream_init(&stream, NULL, key, sizeof(key), value, sizeof(value), cb, ctx);
+
+    rewind(file);
+
+    size_t len;
+    while ((len = fread(chunk, 1, sizeof(chunk), file)) > 0)
+    {
+        if (kv_stream_feed(&stream, chunk, len))
+        {
+            return 1;
+        }
+    }
+
+    return kv_stream_finish(&stream);
+}
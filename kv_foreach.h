@@ -0,0 +1,71 @@
+/**
+ * @file kv_foreach.h
+ * @brief Enumerates every key-value pair in one pass.
+ *
+ * This file contains functions that walk a formatted key-value string or file (e.g., "key=value" or "key: value")
+ * once and pass each well formed pair to a callback.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_foreach_H
+#define kv_foreach_H
+#include "kv_scan.h"
+#include <stdio.h>
+
+/** Longest key `kv_file_foreach()` reports, including the null terminator. Longer keys are skipped. */
+#ifndef KV_FILE_FOREACH_KEY_MAX
+#define KV_FILE_FOREACH_KEY_MAX 256
+#endif
+
+/** Longest value `kv_file_foreach()` reports, including the null terminator. Longer values are skipped. */
+#ifndef KV_FILE_FOREACH_VALUE_MAX
+#define KV_FILE_FOREACH_VALUE_MAX 4096
+#endif
+
+/**
+ * @brief Called for each key-value pair.
+ *
+ * @param ctx Caller context.
+ * @param pair The key-value pair. Only valid during the call.
+ * @return `0` to continue, or non zero to stop.
+ */
+typedef int (*kv_foreach_cb)(void *ctx, const kv_pair *pair);
+
+/**
+ * @brief Calls `cb` for every key-value pair in a given string.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Lines are parsed with the same rules as `kv_get_value()`. Pairs are reported in order, including later duplicates
+ * of a key. Key and value are slices of `str`; if `KV_VALUE_ESCAPED` is set, resolve the value with `kv_scan_unescape()`.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param cb Callback fired for each pair.
+ * @param ctx Caller context passed to `cb`.
+ * @return `1` if the callback stopped the walk, otherwise `0`.
+ *
+ * @example Usage Example:
+ * @code
+ * static int print_pair(void *ctx, const kv_pair *pair) {
+ *     printf("%.*s = %.*s\n", (int)pair->key_len, pair->key, (int)pair->value_len, pair->value);
+ *     return 0;
+ * }
+ * kv_foreach("username=admin\npassword=1234", print_pair, NULL);
+ * @endcode
+ */
+int kv_foreach(const char *str, kv_foreach_cb cb, void *ctx);
+
+/**
+ * @brief Calls `cb` for every key-value pair in a given file.
+ *
+ * Lines are parsed with the same rules as `kv_file_get_value()`, reading the file once from the start in blocks.
+ * Key and value are NUL terminated copies with quotes already resolved. Pairs whose key or value does not fit
+ * `KV_FILE_FOREACH_KEY_MAX` or `KV_FILE_FOREACH_VALUE_MAX` are skipped.
+ *
+ * @param file Input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @param cb Callback fired for each pair.
+ * @param ctx Caller context passed to `cb`.
+ * @return `1` if the callback stopped the walk, otherwise `0`.
+ */
+int kv_file_foreach(FILE *file, kv_foreach_cb cb, void *ctx);
+#endif
@@ -0,0 +1,372 @@
+/**
+ * @file kv_get_typed.c
+ * @brief Typed key-value lookups for numbers and booleans.
+ *
+ * This file contains functions that locate the value associated with a key in a formatted key-value
+ * string or file (e.g., "key=value" or "key: value") and parse it as an integer, a double or a boolean.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_get_typed.h"
+#include "kv_scan.h"
+#include <errno.h>
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Locates the value of `key` in `str`. The value is left in place unless it needs quotes resolved into `buf`. */
+static int kv_typed_find(const char *str, const char *key, char *buf, const char **value, size_t *value_len)
+{
+    kv_pair pair;
+    if (!kv_scan_find(str, NULL, key, &pair))
+    {
+        return KV_TYPED_NOT_FOUND;
+    }
+
+    if (!(pair.flags & KV_VALUE_ESCAPED))
+    {
+        *value = pair.value;
+        *value_len = pair.value_len;
+        return KV_TYPED_OK;
+    }
+
+    *value = buf;
+    *value_len = kv_scan_unescape(pair.value, pair.value_len, pair.flags, buf, KV_TYPED_VALUE_MAX);
+    return *value_len > 0 ? KV_TYPED_OK : KV_TYPED_INVALID;
+}
+
+/* Copies the value of `key` in `file` into `buf`, using the same rules as kv_file_get_value(). */
+static int kv_file_typed_find(FILE *file, const char *key, char *buf, size_t *value_len)
+{
+    rewind(file);
+
+    for (int ch = getc(file); ch != EOF; ch = getc(file))
+    {
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Check For Key */
+        for (int i = 0; key[i] != '\0'; i++, ch = getc(file))
+        {
+            if (ch != key[i])
+            {
+                goto skip_line;
+            }
+        }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Check For Key Value Delimiter */
+        if (ch != '=' && ch != ':')
+        {
+            goto skip_line;
+        }
+        ch = getc(file);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Copy Value To Buffer */
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        int quote = EOF;
+        int prev = EOF;
+#endif
+        size_t i = 0;
+        for (;; ch = getc(file))
+        {
+            if (ch == EOF || ch == '\r' || ch == '\n')
+            {
+                /* End Of Line. Trim trailing whitespace. */
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                while (i > 0 && (buf[i - 1] == ' ' || buf[i - 1] == '\t'))
+                {
+                    i--;
+                }
+#endif
+                break;
+            }
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+            else if (quote == EOF && (ch == '\'' || ch == '"'))
+            {
+                /* Start Of Quoted String */
+                quote = ch;
+                continue;
+            }
+            else if (quote != EOF && prev != '\\' && ch == quote)
+            {
+                /* End Of Quoted String */
+                break;
+            }
+            else if (quote != EOF && prev == '\\' && ch == quote)
+            {
+                /* Escaped Quote Character In Quoted String */
+                buf[i - 1] = ch;
+                continue;
+            }
+
+            prev = ch;
+#endif
+
+            if (i + 1 >= KV_TYPED_VALUE_MAX)
+            {
+                /* Value too large for buffer. First occurrence wins, so stop here. */
+                return KV_TYPED_INVALID;
+            }
+            buf[i++] = ch;
+        }
+
+        *value_len = i;
+        return KV_TYPED_OK;
+
+    skip_line:
+        /* Search for start of next line */
+        while (ch != '\n')
+        {
+            if (ch == EOF)
+            {
+                return KV_TYPED_NOT_FOUND;
+            }
+            ch = getc(file);
+        }
+    }
+
+    /* End of file. Key was not found. */
+    return KV_TYPED_NOT_FOUND;
+}
+
+/* Parses unsigned decimal or 0x hexadecimal digits no larger than `limit`. */
+static int kv_typed_parse_digits(const char *str, size_t len, uint64_t limit, uint64_t *out)
+{
+    unsigned int base = 10;
+    if (len > 2 && str[0] == '0' && (str[1] == 'x' || str[1] == 'X'))
+    {
+        base = 16;
+        str += 2;
+        len -= 2;
+    }
+
+    if (len == 0)
+    {
+        return KV_TYPED_INVALID;
+    }
+
+    uint64_t result = 0;
+    int overflow = 0;
+    for (size_t i = 0; i < len; i++)
+    {
+        unsigned int digit;
+        if (str[i] >= '0' && str[i] <= '9')
+        {
+            digit = str[i] - '0';
+        }
+        else if (base == 16 && (str[i] | 0x20) >= 'a' && (str[i] | 0x20) <= 'f')
+        {
+            digit = (str[i] | 0x20) - 'a' + 10;
+        }
+        else
+        {
+            return KV_TYPED_INVALID;
+        }
+
+        /* Keep checking the remaining characters, so trailing garbage is reported as invalid */
+        if (overflow || result > (limit - digit) / base)
+        {
+            overflow = 1;
+            continue;
+        }
+        result = result * base + digit;
+    }
+
+    if (overflow)
+    {
+        return KV_TYPED_OVERFLOW;
+    }
+    *out = result;
+    return KV_TYPED_OK;
+}
+
+static int kv_typed_parse_int64(const char *str, size_t len, int64_t *out)
+{
+    int negative = 0;
+    if (len > 0 && (str[0] == '-' || str[0] == '+'))
+    {
+        negative = str[0] == '-';
+        str++;
+        len--;
+    }
+
+    uint64_t magnitude;
+    const uint64_t limit = negative ? (uint64_t)INT64_MAX + 1 : (uint64_t)INT64_MAX;
+    const int status = kv_typed_parse_digits(str, len, limit, &magnitude);
+    if (status != KV_TYPED_OK)
+    {
+        return status;
+    }
+
+    if (!negative)
+    {
+        *out = (int64_t)magnitude;
+    }
+    else if (magnitude == (uint64_t)INT64_MAX + 1)
+    {
+        *out = INT64_MIN;
+    }
+    else
+    {
+        *out = -(int64_t)magnitude;
+    }
+    return KV_TYPED_OK;
+}
+
+static int kv_typed_parse_uint64(const char *str, size_t len, uint64_t *out)
+{
+    if (len > 0 && str[0] == '+')
+    {
+        str++;
+        len--;
+    }
+    return kv_typed_parse_digits(str, len, UINT64_MAX, out);
+}
+
+static int kv_typed_parse_double(const char *str, size_t len, double *out)
+{
+    /* strtod() needs a NUL terminated string, and must not skip leading whitespace */
+    char number[KV_TYPED_VALUE_MAX];
+    if (len == 0 || len >= sizeof(number) || str[0] == ' ' || str[0] == '\t')
+    {
+        return KV_TYPED_INVALID;
+    }
+    memcpy(number, str, len);
+    number[len] = '\0';
+
+    char *end;
+    errno = 0;
+    const double result = strtod(number, &end);
+    if (end != number + len)
+    {
+        return KV_TYPED_INVALID;
+    }
+    if (errno == ERANGE && (result == HUGE_VAL || result == -HUGE_VAL))
+    {
+        return KV_TYPED_OVERFLOW;
+    }
+    *out = result;
+    return KV_TYPED_OK;
+}
+
+/* Compares a value slice against a lower case word, ignoring letter case */
+static int kv_typed_word_equal(const char *str, size_t len, const char *word)
+{
+    size_t i = 0;
+    for (; i < len && word[i] != '\0'; i++)
+    {
+        const char ch = (str[i] >= 'A' && str[i] <= 'Z') ? str[i] + ('a' - 'A') : str[i];
+        if (ch != word[i])
+        {
+            return 0;
+        }
+    }
+    return i == len && word[i] == '\0';
+}
+
+static int kv_typed_parse_bool(const char *str, size_t len, int *out)
+{
+    static const char *const true_words[] = {"true", "yes", "on", "1"};
+    static const char *const false_words[] = {"false", "no", "off", "0"};
+    for (size_t i = 0; i < sizeof(true_words) / sizeof(true_words[0]); i++)
+    {
+        if (kv_typed_word_equal(str, len, true_words[i]))
+        {
+            *out = 1;
+            return KV_TYPED_OK;
+        }
+        if (kv_typed_word_equal(str, len, false_words[i]))
+        {
+            *out = 0;
+            return KV_TYPED_OK;
+        }
+    }
+    return KV_TYPED_INVALID;
+}
+
+int kv_get_int64(const char *str, const char *key, int64_t *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    const char *value;
+    size_t value_len;
+    const int status = kv_typed_find(str, key, buf, &value, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_int64(value, value_len, out);
+}
+
+int kv_get_uint64(const char *str, const char *key, uint64_t *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    const char *value;
+    size_t value_len;
+    const int status = kv_typed_find(str, key, buf, &value, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_uint64(value, value_len, out);
+}
+
+int kv_get_double(const char *str, const char *key, double *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    const char *value;
+    size_t value_len;
+    const int status = kv_typed_find(str, key, buf, &value, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_double(value, value_len, out);
+}
+
+int kv_get_bool(const char *str, const char *key, int *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    const char *value;
+    size_t value_len;
+    const int status = kv_typed_find(str, key, buf, &value, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_bool(value, value_len, out);
+}
+
+int kv_file_get_int64(FILE *file, const char *key, int64_t *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    size_t value_len;
+    const int status = kv_file_typed_find(file, key, buf, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_int64(buf, value_len, out);
+}
+
+int kv_file_get_uint64(FILE *file, const char *key, uint64_t *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    size_t value_len;
+    const int status = kv_file_typed_find(file, key, buf, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_uint64(buf, value_len, out);
+}
+
+int kv_file_get_double(FILE *file, const char *key, double *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    size_t value_len;
+    const int status = kv_file_typed_find(file, key, buf, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_double(buf, value_len, out);
+}
+
+int kv_file_get_bool(FILE *file, const char *key, int *out)
+{
+    char buf[KV_TYPED_VALUE_MAX];
+    size_t value_len;
+    const int status = kv_file_typed_find(file, key, buf, &value_len);
+    return status != KV_TYPED_OK ? status : kv_typed_parse_bool(buf, value_len, out);
+}
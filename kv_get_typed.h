@@ -0,0 +1,131 @@
+/**
+ * @file kv_get_typed.h
+ * @brief Typed key-value lookups for numbers and booleans.
+ *
+ * This file contains functions that locate the value associated with a key in a formatted key-value
+ * string or file (e.g., "key=value" or "key: value") and parse it as an integer, a double or a boolean.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_get_typed_H
+#define kv_get_typed_H
+#include <stdint.h>
+#include <stdio.h>
+
+/** Value parsed. */
+#define KV_TYPED_OK 0
+/** Key not found. */
+#define KV_TYPED_NOT_FOUND -1
+/** Value is empty, too long, or not of the requested type. */
+#define KV_TYPED_INVALID -2
+/** Value is a number outside the range of the requested type. */
+#define KV_TYPED_OVERFLOW -3
+
+/** Longest value (including the null terminator) copied when a value has to be resolved into a buffer before parsing. */
+#ifndef KV_TYPED_VALUE_MAX
+#define KV_TYPED_VALUE_MAX 64
+#endif
+
+/**
+ * @brief Parses the value of a key as a signed 64 bit integer.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * The key is located with the same rules as `kv_get_value()` and the value is parsed where it lies in `str`,
+ * without copying it out first. Quoted values such as `"42"` are accepted. Decimal and `0x` hexadecimal
+ * digits are accepted, with an optional leading `+` or `-`. Nothing else may follow the digits.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param key The key to search for in the input string.
+ * @param out Output value. Only written on success, so it can be preset to a default.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND`, `KV_TYPED_INVALID` or `KV_TYPED_OVERFLOW`.
+ *
+ * @example Usage Example:
+ * @code
+ * int64_t port = 8080;
+ * if (kv_get_int64("host=example.com\nport=443", "port", &port) == KV_TYPED_OVERFLOW) {
+ *     printf("Port out of range.\n");
+ * }
+ * @endcode
+ */
+int kv_get_int64(const char *str, const char *key, int64_t *out);
+
+/**
+ * @brief Parses the value of a key as an unsigned 64 bit integer.
+ *
+ * Same as `kv_get_int64()`, but a leading `-` is invalid.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param key The key to search for in the input string.
+ * @param out Output value. Only written on success.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND`, `KV_TYPED_INVALID` or `KV_TYPED_OVERFLOW`.
+ */
+int kv_get_uint64(const char *str, const char *key, uint64_t *out);
+
+/**
+ * @brief Parses the value of a key as a double.
+ *
+ * Accepts the same syntax as `strtod()`, except that leading whitespace and trailing characters are invalid.
+ * Values whose magnitude is too large for a double are reported as `KV_TYPED_OVERFLOW`.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param key The key to search for in the input string.
+ * @param out Output value. Only written on success.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND`, `KV_TYPED_INVALID` or `KV_TYPED_OVERFLOW`.
+ */
+int kv_get_double(const char *str, const char *key, double *out);
+
+/**
+ * @brief Parses the value of a key as a boolean.
+ *
+ * Accepts `true`/`false`, `yes`/`no`, `on`/`off` (in any letter case) and `1`/`0`.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param key The key to search for in the input string.
+ * @param out Output value, `1` or `0`. Only written on success.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND` or `KV_TYPED_INVALID`.
+ */
+int kv_get_bool(const char *str, const char *key, int *out);
+
+/**
+ * @brief Parses the value of a key in a file as a signed 64 bit integer.
+ *
+ * Same as `kv_get_int64()`, reading the file from the start like `kv_file_get_value()`.
+ *
+ * @param file Input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @param key The key to search for in the input file.
+ * @param out Output value. Only written on success.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND`, `KV_TYPED_INVALID` or `KV_TYPED_OVERFLOW`.
+ */
+int kv_file_get_int64(FILE *file, const char *key, int64_t *out);
+
+/**
+ * @brief Parses the value of a key in a file as an unsigned 64 bit integer.
+ *
+ * @param file Input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @param key The key to search for in the input file.
+ * @param out Output value. Only written on success.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND`, `KV_TYPED_INVALID` or `KV_TYPED_OVERFLOW`.
+ */
+int kv_file_get_uint64(FILE *file, const char *key, uint64_t *out);
+
+/**
+ * @brief Parses the value of a key in a file as a double.
+ *
+ * @param file Input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @param key The key to search for in the input file.
+ * @param out Output value. Only written on success.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND`, `KV_TYPED_INVALID` or `KV_TYPED_OVERFLOW`.
+ */
+int kv_file_get_double(FILE *file, const char *key, double *out);
+
+/**
+ * @brief Parses the value of a key in a file as a boolean.
+ *
+ * @param file Input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @param key The key to search for in the input file.
+ * @param out Output value, `1` or `0`. Only written on success.
+ * @return `KV_TYPED_OK`, `KV_TYPED_NOT_FOUND` or `KV_TYPED_INVALID`.
+ */
+int kv_file_get_bool(FILE *file, const char *key, int *out);
+#endif
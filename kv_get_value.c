@@ -8,41 +8,135 @@
  * This code is released to the public domain by Brian Khuu in 2025.
  */
 
-unsigned int kv_get_value(const char *str, const char *key, char *value, unsigned int value_max)
+/* kv_get_value() is generated from the same template as the kv_get_value_variants.c variants, with the features picked by the KV_PARSE_DISABLE_* flags */
+#define KV_VARIANT_NAME kv_get_value
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+#define KV_VARIANT_WHITESPACE_SKIP 1
+#else
+#define KV_VARIANT_WHITESPACE_SKIP 0
+#endif
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+#define KV_VARIANT_QUOTED_STRINGS 1
+#else
+#define KV_VARIANT_QUOTED_STRINGS 0
+#endif
+#include "kv_get_value_variant.inc"
+#include "kv_get_value.h"
+#include <stddef.h>
+
+/* Copies the value at `str` into `value` using the same rules as kv_get_value(). Returns the end of the value. */
+static const char *kv_get_values_copy(const char *str, char *value, unsigned int value_max, unsigned int *value_len)
 {
-    for (; *str != '\0'; str++)
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    char quote = '\0';
+#endif
+    unsigned int i = 0;
+    for (; *str != '\0' && *str != '\r' && *str != '\n'; str++)
     {
-#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-        while (*str == ' ' || *str == '\t')
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        if (quote == '\0' && (*str == '\'' || *str == '"'))
         {
-            str++;
+            /* Start Of Quoted String */
+            quote = *str;
+            continue;
+        }
+        else if (quote != '\0' && *(str - 1) != '\\' && *str == quote)
+        {
+            /* End Of Quoted String. Return Value */
+            value[i] = '\0';
+            *value_len = i;
+            return str;
+        }
+        else if (quote != '\0' && *(str - 1) == '\\' && *str == quote)
+        {
+            /* Escaped Quote Character In Quoted String */
+            value[i - 1] = *str;
+            continue;
         }
 #endif
 
-        /* Check For Key */
-        for (int i = 0; *str != '\0' && key[i] != '\0'; i++, str++)
+        if (i + 1 >= value_max)
         {
-            /* Key Mismatched. Skip Line */
-            if (*str != key[i])
-            {
-                goto skip_line;
-            }
+            /* Value too large for buffer. Don't return a value. */
+            value[0] = '\0';
+            *value_len = 0;
+            return str;
         }
+        value[i++] = *str;
+    }
 
+    /* End Of Line. Trim trailing whitespace before returning the value. */
+    value[i] = '\0';
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-        while (*str == ' ' || *str == '\t')
-        {
-            str++;
-        }
+    while (i > 0 && (value[i - 1] == ' ' || value[i - 1] == '\t'))
+    {
+        i--;
+        value[i] = '\0';
+    }
+#endif
+    *value_len = i;
+    return str;
+}
+
+/* Matches `key` at the start of a line the way kv_get_value() does. Returns the start of the value, or NULL if the line does not hold the key. */
+static const char *kv_get_values_match(const char *str, const char *key)
+{
+    while (*key != '\0' && *str == *key)
+    {
+        str++;
+        key++;
+    }
+    if (*key != '\0')
+    {
+        return NULL;
+    }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (*str == ' ' || *str == '\t')
+    {
+        str++;
+    }
+#endif
+
+    /* Check For Key Value Delimiter */
+    if (*str != '=' && *str != ':')
+    {
+        return NULL;
+    }
+    str++;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (*str == ' ' || *str == '\t')
+    {
+        str++;
+    }
+#endif
+    return str;
+}
+
+/* Resolves up to KV_GET_VALUES_BATCH keys in one scan of the string */
+static unsigned int kv_get_values_batch(const char *str, const char *const keys[], unsigned int nkeys, char *const out_bufs[], const unsigned int out_max[], unsigned int out_lens[])
+{
+#ifdef KV_PARSE_SIMD
+    const kv_find_eol_fn kv_find_eol = kv_find_eol_select();
 #endif
 
-        /* Check For Key Value Delimiter */
-        if (*str != '=' && *str != ':')
+    /* Keys resolved so far. First occurrence wins. */
+    unsigned char resolved[KV_GET_VALUES_BATCH];
+    for (unsigned int k = 0; k < nkeys; k++)
+    {
+        resolved[k] = 0;
+        out_lens[k] = 0;
+        if (out_max[k] > 0)
         {
-            goto skip_line;
+            out_bufs[k][0] = '\0';
         }
-        str++;
+    }
 
+    unsigned int found = 0;
+    unsigned int remaining = nkeys;
+    while (*str != '\0' && remaining > 0)
+    {
 #ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
         while (*str == ' ' || *str == '\t')
         {
@@ -50,66 +144,52 @@ unsigned int kv_get_value(const char *str, const char *key, char *value, unsigne
         }
 #endif
 
-        /* Copy Value To Buffer */
-#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
-        char quote = '\0';
-#endif
-        for (int i = 0; i < (value_max - 1); str++)
+        /* Check Every Unresolved Key Against This Line. One line may hold several keys, e.g. "a=b=1" holds "a" and "a=b". */
+        for (unsigned int k = 0; k < nkeys; k++)
         {
-            if (*str == '\0' || *str == '\r' || *str == '\n')
-            {
-                /* End Of Line. Trim trailing whitespace before returning the value. */
-                value[i] = '\0';
-#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
-                while (i > 0 && (value[i - 1] == ' ' || value[i - 1] == '\t'))
-                {
-                    i--;
-                    value[i] = '\0';
-                }
-#endif
-                return i;
-            }
-#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
-            else if (quote == '\0' && (*str == '\'' || *str == '"'))
+            const char *value = resolved[k] ? NULL : kv_get_values_match(str, keys[k]);
+            if (value == NULL)
             {
-                /* Start Of Quoted String */
-                quote = *str;
                 continue;
             }
-            else if (quote != '\0' && *(str - 1) != '\\' && *str == quote)
-            {
-                /* End Of Quoted String. Return Value */
-                value[i] = '\0';
-                return i;
-            }
-            else if (quote != '\0' && *(str - 1) == '\\' && *str == quote)
+
+            resolved[k] = 1;
+            remaining--;
+            if (out_max[k] > 0)
             {
-                /* Escaped Quote Character In Quoted String */
-                value[i - 1] = *str;
-                continue;
+                kv_get_values_copy(value, out_bufs[k], out_max[k], &out_lens[k]);
             }
-#endif
-
-            value[i++] = *str;
+            found += out_lens[k] > 0;
         }
 
-        /* Value too large for buffer. Don't return a value. */
-        value[0] = '\0';
-        return 0;
-
-    skip_line:
         /* Search for start of next line */
-        while (*str != '\n')
+#ifdef KV_PARSE_SIMD
+        str = kv_find_eol(str);
+#else
+        while (*str != '\0' && *str != '\n')
         {
-            if (*str == '\0')
-            {
-                /* End of string. Key was not found. */
-                return 0;
-            }
             str++;
         }
+#endif
+        if (*str == '\0')
+        {
+            /* End of string. */
+            break;
+        }
+        str++;
     }
 
-    /* End of string. Key was not found. */
-    return 0;
+    return found;
+}
+
+unsigned int kv_get_values(const char *str, const char *const keys[], unsigned int nkeys, char *const out_bufs[], const unsigned int out_max[], unsigned int out_lens[])
+{
+    /* Fixed size state per batch, so the stack use does not depend on nkeys */
+    unsigned int found = 0;
+    for (unsigned int first = 0; first < nkeys; first += KV_GET_VALUES_BATCH)
+    {
+        const unsigned int batch = nkeys - first < KV_GET_VALUES_BATCH ? nkeys - first : KV_GET_VALUES_BATCH;
+        found += kv_get_values_batch(str, keys + first, batch, out_bufs + first, out_max + first, out_lens + first);
+    }
+    return found;
 }
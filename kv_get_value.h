@@ -9,6 +9,12 @@
  */
 #ifndef kv_get_value_H
 #define kv_get_value_H
+
+/** Keys `kv_get_values()` resolves per scan of the string. More keys take more scans, keeping stack use fixed. */
+#ifndef KV_GET_VALUES_BATCH
+#define KV_GET_VALUES_BATCH 64
+#endif
+
 /**
  * @brief Parses a key-value pair from a given string.
  *
@@ -43,4 +49,32 @@
  * @endcode
  */
 unsigned int kv_get_value(const char *str, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Parses several key-value pairs from a given string in a single pass.
+ *
+ * This function resolves a whole set of keys with one scan over the input string (one per
+ * `KV_GET_VALUES_BATCH` keys), instead of calling `kv_get_value()` once per key. Each key is matched
+ * as a prefix of the line exactly as `kv_get_value()` does, including first occurrence wins, so a line
+ * such as `"a=b=1"` resolves both `"a"` and `"a=b"`.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param keys The keys to search for in the input string.
+ * @param nkeys Number of entries in `keys`, `out_bufs`, `out_max` and `out_lens`.
+ * @param out_bufs Output buffers to store each extracted value.
+ * @param out_max Maximum length of each output buffer, including the null terminator.
+ * @param out_lens Length of each extracted value (excluding the null terminator), or `0` if the key is not found.
+ * @return The number of keys with a value found.
+ *
+ * @example Usage Example:
+ * @code
+ * char user[50], pass[50];
+ * const char *keys[] = {"username", "password"};
+ * char *bufs[] = {user, pass};
+ * unsigned int maxs[] = {sizeof(user), sizeof(pass)};
+ * unsigned int lens[2];
+ * kv_get_values("username=admin\npassword=1234", keys, 2, bufs, maxs, lens);
+ * @endcode
+ */
+unsigned int kv_get_values(const char *str, const char *const keys[], unsigned int nkeys, char *const out_bufs[], const unsigned int out_max[], unsigned int out_lens[]);
 #endif
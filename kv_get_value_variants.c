@@ -0,0 +1,49 @@
+/**
+ * @file kv_get_value_variants.c
+ * @brief Compile time specialised `kv_get_value()` variants in one binary.
+ *
+ * This file contains the four feature combinations of `kv_get_value()`, each generated from one source with its
+ * features fixed at compile time, and a parser handle that picks a variant once from runtime options. This lets one
+ * program read strict and relaxed key-value formats side by side, regardless of the `KV_PARSE_DISABLE_*` flags.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_get_value_variants.h"
+
+#define KV_VARIANT_NAME kv_get_value_strict
+#define KV_VARIANT_WHITESPACE_SKIP 0
+#define KV_VARIANT_QUOTED_STRINGS 0
+#include "kv_get_value_variant.inc"
+
+#define KV_VARIANT_NAME kv_get_value_ws
+#define KV_VARIANT_WHITESPACE_SKIP 1
+#define KV_VARIANT_QUOTED_STRINGS 0
+#include "kv_get_value_variant.inc"
+
+#define KV_VARIANT_NAME kv_get_value_quoted
+#define KV_VARIANT_WHITESPACE_SKIP 0
+#define KV_VARIANT_QUOTED_STRINGS 1
+#include "kv_get_value_variant.inc"
+
+#define KV_VARIANT_NAME kv_get_value_full
+#define KV_VARIANT_WHITESPACE_SKIP 1
+#define KV_VARIANT_QUOTED_STRINGS 1
+#include "kv_get_value_variant.inc"
+
+kv_get_value_fn kv_get_value_select(unsigned int options)
+{
+    static const kv_get_value_fn variants[4] = {kv_get_value_strict, kv_get_value_ws, kv_get_value_quoted, kv_get_value_full};
+    return variants[options & (KV_PARSE_WHITESPACE_SKIP | KV_PARSE_QUOTED_STRINGS)];
+}
+
+void kv_parser_init(kv_parser *parser, unsigned int options)
+{
+    parser->get_value = kv_get_value_select(options);
+    parser->options = options;
+}
+
+unsigned int kv_parser_get_value(const kv_parser *parser, const char *str, const char *key, char *value, unsigned int value_max)
+{
+    return parser->get_value(str, key, value, value_max);
+}
@@ -0,0 +1,93 @@
+/**
+ * @file kv_get_value_variants.h
+ * @brief Compile time specialised `kv_get_value()` variants in one binary.
+ *
+ * This file contains the four feature combinations of `kv_get_value()`, each generated from one source with its
+ * features fixed at compile time, and a parser handle that picks a variant once from runtime options. This lets one
+ * program read strict and relaxed key-value formats side by side, regardless of the `KV_PARSE_DISABLE_*` flags.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_get_value_variants_H
+#define kv_get_value_variants_H
+
+/** Option: ignore spaces and tabs around keys and values. */
+#define KV_PARSE_WHITESPACE_SKIP 0x01u
+/** Option: handle values enclosed in single (`'`) or double (`"`) quotes. */
+#define KV_PARSE_QUOTED_STRINGS 0x02u
+
+/**
+ * @brief Signature shared by `kv_get_value()` and every variant.
+ */
+typedef unsigned int (*kv_get_value_fn)(const char *str, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Parser handle with its variant resolved once.
+ */
+typedef struct
+{
+    kv_get_value_fn get_value; /**< Variant matching `options`. */
+    unsigned int options;      /**< `KV_PARSE_*` options the handle was created with. */
+} kv_parser;
+
+/**
+ * @brief `kv_get_value()` with no whitespace skipping and no quoted strings.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Same parameters and return value as `kv_get_value()`.
+ */
+unsigned int kv_get_value_strict(const char *str, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief `kv_get_value()` with whitespace skipping only.
+ */
+unsigned int kv_get_value_ws(const char *str, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief `kv_get_value()` with quoted strings only.
+ */
+unsigned int kv_get_value_quoted(const char *str, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief `kv_get_value()` with whitespace skipping and quoted strings.
+ */
+unsigned int kv_get_value_full(const char *str, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Returns the variant for a set of options.
+ *
+ * @param options Bitwise OR of `KV_PARSE_WHITESPACE_SKIP` and `KV_PARSE_QUOTED_STRINGS`.
+ * @return The matching `kv_get_value_*` function.
+ */
+kv_get_value_fn kv_get_value_select(unsigned int options);
+
+/**
+ * @brief Initialises a parser handle, selecting its variant once.
+ *
+ * @param parser Handle to initialise.
+ * @param options Bitwise OR of `KV_PARSE_WHITESPACE_SKIP` and `KV_PARSE_QUOTED_STRINGS`.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_parser strict, relaxed;
+ * char buffer[50];
+ * kv_parser_init(&strict, 0);
+ * kv_parser_init(&relaxed, KV_PARSE_WHITESPACE_SKIP | KV_PARSE_QUOTED_STRINGS);
+ * unsigned int len = kv_parser_get_value(&relaxed, "name = \"Ada\"", "name", buffer, sizeof(buffer));
+ * @endcode
+ */
+void kv_parser_init(kv_parser *parser, unsigned int options);
+
+/**
+ * @brief Parses a key-value pair from a given string with the handle's variant.
+ *
+ * @param parser Handle initialised with `kv_parser_init()`.
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param key The key to search for in the input string.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found.
+ */
+unsigned int kv_parser_get_value(const kv_parser *parser, const char *str, const char *key, char *value, unsigned int value_max);
+#endif
@@ -0,0 +1,38 @@
+/**
+ * @file kv_get_value_view.c
+ * @brief Zero-copy key-value lookups.
+ *
+ * This file contains a parser function that locates the value associated with a key in a formatted
+ * key-value string (e.g., "key=value" or "key: value") and returns it as a slice of that string.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_get_value_view.h"
+
+kv_value_view kv_get_value_view(const char *str, const char *key)
+{
+    kv_value_view view = {NULL, 0, 0};
+    kv_pair pair;
+    if (kv_scan_find(str, NULL, key, &pair))
+    {
+        view.ptr = pair.value;
+        view.len = pair.value_len;
+        view.flags = pair.flags;
+    }
+    return view;
+}
+
+unsigned int kv_value_view_copy(kv_value_view view, char *value, unsigned int value_max)
+{
+    if (view.ptr == NULL)
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    return kv_scan_unescape(view.ptr, view.len, view.flags, value, value_max);
+}
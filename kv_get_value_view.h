@@ -0,0 +1,63 @@
+/**
+ * @file kv_get_value_view.h
+ * @brief Zero-copy key-value lookups.
+ *
+ * This file contains a parser function that locates the value associated with a key in a formatted
+ * key-value string (e.g., "key=value" or "key: value") and returns it as a slice of that string.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_get_value_view_H
+#define kv_get_value_view_H
+#include "kv_scan.h"
+#include <stddef.h>
+
+/**
+ * @brief Slice of the source string holding a value.
+ *
+ * Not NUL terminated. Only valid while the source string is.
+ */
+typedef struct
+{
+    const char *ptr;    /**< Start of the value, or `NULL` if the key is not found. */
+    size_t len;         /**< Length of the value slice. */
+    unsigned int flags; /**< `KV_VALUE_QUOTED` if the value was quoted, `KV_VALUE_ESCAPED` if the slice still needs kv_value_view_copy() to resolve quotes. */
+} kv_value_view;
+
+/**
+ * @brief Locates a key-value pair in a given string without copying.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Applies the same rules as `kv_get_value()`. Unlike `kv_get_value()` a missing key (`ptr == NULL`) can be told
+ * apart from an empty value (`len == 0`), and there is no output buffer that can be too small.
+ *
+ * If `KV_VALUE_ESCAPED` is clear, `ptr`/`len` is exactly the value `kv_get_value()` would copy out.
+ * Otherwise it is the raw source text, including quote characters, and must go through `kv_value_view_copy()`.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param key The key to search for in the input string.
+ * @return View of the value. `ptr` is `NULL` if the key is not found.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_value_view view = kv_get_value_view("username=admin\npassword=1234", "username");
+ * if (view.ptr != NULL && !(view.flags & KV_VALUE_ESCAPED)) {
+ *     printf("Username: %.*s\n", (int)view.len, view.ptr);
+ * }
+ * @endcode
+ */
+kv_value_view kv_get_value_view(const char *str, const char *key);
+
+/**
+ * @brief Copies a value view into a buffer, resolving quotes and escaped quotes.
+ *
+ * A buffer of `view.len + 1` bytes is always large enough.
+ *
+ * @param view View returned by `kv_get_value_view()`.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator), or `0` if the key was not found or it does not fit.
+ */
+unsigned int kv_value_view_copy(kv_value_view view, char *value, unsigned int value_max);
+#endif
@@ -0,0 +1,184 @@
+/**
+ * @file kv_index.c
+ * @brief Hash index over a key-value string for repeated lookups.
+ *
+ * This file contains functions that parse a formatted key-value string (e.g., "key=value" or "key: value")
+ * once into an open-addressing hash table, so that later lookups do not rescan the string.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_index.h"
+#include "kv_scan.h"
+#include <string.h>
+
+unsigned int kv_index_hash(const char *key, size_t key_len)
+{
+    /* FNV-1a */
+    unsigned int hash = 2166136261u;
+    for (size_t i = 0; i < key_len; i++)
+    {
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+int kv_index_init(kv_index *index, const char *str, kv_index_entry *slots, size_t slot_count)
+{
+    index->str = str;
+    index->slots = slots;
+    index->slot_count = slot_count;
+    index->count = 0;
+
+    if (slot_count == 0 || (slot_count & (slot_count - 1)) != 0)
+    {
+        return -1;
+    }
+    memset(slots, 0, slot_count * sizeof(*slots));
+    return 0;
+}
+
+int kv_index_add(kv_index *index, const kv_index_entry *add)
+{
+    const size_t mask = index->slot_count - 1;
+    for (size_t slot = add->hash & mask;; slot = (slot + 1) & mask)
+    {
+        kv_index_entry *entry = &index->slots[slot];
+        if (!(entry->flags & KV_INDEX_SLOT_USED))
+        {
+            /* Always leave one empty slot so lookups of missing keys terminate */
+            if (index->count + 1 >= index->slot_count)
+            {
+                return -1;
+            }
+            *entry = *add;
+            entry->flags |= KV_INDEX_SLOT_USED;
+            index->count++;
+            return 0;
+        }
+
+        if (entry->hash == add->hash && entry->key_len == add->key_len && memcmp(index->str + entry->key_offset, index->str + add->key_offset, add->key_len) == 0)
+        {
+            /* Duplicate Key. First occurrence wins. */
+            return 0;
+        }
+    }
+}
+
+/* Indexes every pair in [str, end), or up to the NUL terminator if end is NULL */
+static int kv_index_add_lines(kv_index *index, const char *str, const char *end)
+{
+    const char *line = str;
+    while (end ? line < end : *line != '\0')
+    {
+        kv_pair pair;
+        line = kv_scan_pair(line, end, &pair);
+        if (pair.key == NULL)
+        {
+            continue;
+        }
+
+        kv_index_entry entry;
+        entry.key_offset = pair.key - index->str;
+        entry.key_len = pair.key_len;
+        entry.value_offset = pair.value - index->str;
+        entry.value_len = pair.value_len;
+        entry.hash = kv_index_hash(pair.key, pair.key_len);
+        entry.flags = pair.flags;
+        if (kv_index_add(index, &entry) != 0)
+        {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int kv_index_build(kv_index *index, const char *str, kv_index_entry *slots, size_t slot_count)
+{
+    if (kv_index_init(index, str, slots, slot_count) != 0)
+    {
+        return -1;
+    }
+    return kv_index_add_lines(index, str, NULL);
+}
+
+int kv_index_build_n(kv_index *index, const char *str, size_t len, kv_index_entry *slots, size_t slot_count)
+{
+    if (kv_index_init(index, str, slots, slot_count) != 0)
+    {
+        return -1;
+    }
+    return kv_index_add_lines(index, str, str + len);
+}
+
+size_t kv_index_slot_count(const char *str)
+{
+    return kv_index_slot_count_n(str, strlen(str));
+}
+
+size_t kv_index_slot_count_n(const char *str, size_t len)
+{
+    size_t lines = 1;
+    for (const char *eol = memchr(str, '\n', len); eol != NULL; eol = memchr(eol + 1, '\n', len - (eol + 1 - str)))
+    {
+        lines++;
+    }
+
+    size_t slot_count = 4;
+    while (slot_count < lines * 2)
+    {
+        slot_count *= 2;
+    }
+    return slot_count;
+}
+
+const kv_index_entry *kv_index_find_hashed(const kv_index *index, const char *key, size_t key_len, unsigned int hash)
+{
+    if (index->slot_count == 0)
+    {
+        return NULL;
+    }
+
+    const size_t mask = index->slot_count - 1;
+    for (size_t slot = hash & mask;; slot = (slot + 1) & mask)
+    {
+        const kv_index_entry *entry = &index->slots[slot];
+        if (!(entry->flags & KV_INDEX_SLOT_USED))
+        {
+            return NULL;
+        }
+
+        if (entry->hash == hash && entry->key_len == key_len && memcmp(index->str + entry->key_offset, key, key_len) == 0)
+        {
+            return entry;
+        }
+    }
+}
+
+const kv_index_entry *kv_index_find(const kv_index *index, const char *key)
+{
+    const size_t key_len = strlen(key);
+    return kv_index_find_hashed(index, key, key_len, kv_index_hash(key, key_len));
+}
+
+/* Copies out the value of an entry found by kv_index_find() */
+static unsigned int kv_index_entry_value(const kv_index *index, const kv_index_entry *entry, char *value, unsigned int value_max)
+{
+    if (entry == NULL)
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    return kv_scan_unescape(index->str + entry->value_offset, entry->value_len, entry->flags & ~KV_INDEX_SLOT_USED, value, value_max);
+}
+
+unsigned int kv_index_get_value(const kv_index *index, const char *key, char *value, unsigned int value_max)
+{
+    return kv_index_entry_value(index, kv_index_find(index, key), value, value_max);
+}
@@ -0,0 +1,161 @@
+/**
+ * @file kv_index.h
+ * @brief Hash index over a key-value string for repeated lookups.
+ *
+ * This file contains functions that parse a formatted key-value string (e.g., "key=value" or "key: value")
+ * once into an open-addressing hash table, so that later lookups do not rescan the string.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_index_H
+#define kv_index_H
+#include <stddef.h>
+
+/** Slot holds an entry. Kept out of the way of the `KV_VALUE_*` flags. */
+#define KV_INDEX_SLOT_USED 0x80u
+
+/**
+ * @brief One slot of the index hash table.
+ *
+ * Offsets are relative to the start of the indexed string.
+ */
+typedef struct
+{
+    size_t key_offset;   /**< Offset of the key in the indexed string. */
+    size_t key_len;      /**< Length of the key. */
+    size_t value_offset; /**< Offset of the value slice in the indexed string. */
+    size_t value_len;    /**< Length of the value slice. */
+    unsigned int hash;   /**< Hash of the key. */
+    unsigned int flags;  /**< `KV_VALUE_*` flags of the value slice (see kv_scan.h), plus `KV_INDEX_SLOT_USED`. */
+} kv_index_entry;
+
+/**
+ * @brief Hash index over a key-value string.
+ *
+ * The indexed string and the slot table are owned by the caller and must outlive the index.
+ */
+typedef struct
+{
+    const char *str;        /**< Indexed string. */
+    kv_index_entry *slots;  /**< Caller provided slot table. */
+    size_t slot_count;      /**< Number of slots. Must be a power of two. */
+    size_t count;           /**< Number of distinct keys indexed. */
+} kv_index;
+
+/**
+ * @brief Hashes a key (FNV-1a).
+ *
+ * @param key Key characters. Need not be NUL terminated.
+ * @param key_len Length of the key.
+ * @return Hash of the key.
+ */
+unsigned int kv_index_hash(const char *key, size_t key_len);
+
+/**
+ * @brief Parses a key-value string once into a hash index.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Lines are parsed with the same rules as `kv_get_value()`. If a key appears more than once, the first
+ * occurrence is kept. No memory is allocated; all entries live in the caller provided `slots` table.
+ *
+ * @param index Index to initialise.
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param slots Slot table storage. Should have room for about twice the number of distinct keys.
+ * @param slot_count Number of entries in `slots`. Must be a power of two.
+ * @return `0` on success, or `-1` if `slot_count` is not a power of two or the table is too small for every key.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_index_entry slots[64];
+ * kv_index index;
+ * char buffer[50];
+ * if (kv_index_build(&index, "username=admin\npassword=1234", slots, 64) == 0) {
+ *     unsigned int len = kv_index_get_value(&index, "username", buffer, sizeof(buffer));
+ * }
+ * @endcode
+ */
+int kv_index_build(kv_index *index, const char *str, kv_index_entry *slots, size_t slot_count);
+
+/**
+ * @brief Parses a length delimited key-value buffer once into a hash index.
+ *
+ * Same as `kv_index_build()`, but the buffer need not be NUL terminated.
+ *
+ * @param index Index to initialise.
+ * @param str Input buffer containing multiple key-value pairs separated by newline.
+ * @param len Length of `str`.
+ * @param slots Slot table storage. Should have room for about twice the number of distinct keys.
+ * @param slot_count Number of entries in `slots`. Must be a power of two.
+ * @return `0` on success, or `-1` if `slot_count` is not a power of two or the table is too small for every key.
+ */
+int kv_index_build_n(kv_index *index, const char *str, size_t len, kv_index_entry *slots, size_t slot_count);
+
+/**
+ * @brief Initialises an empty index, for filling with `kv_index_add()`.
+ *
+ * @param index Index to initialise.
+ * @param str String the entry offsets will be relative to.
+ * @param slots Slot table storage.
+ * @param slot_count Number of entries in `slots`. Must be a power of two.
+ * @return `0` on success, or `-1` if `slot_count` is not a power of two.
+ */
+int kv_index_init(kv_index *index, const char *str, kv_index_entry *slots, size_t slot_count);
+
+/**
+ * @brief Adds an entry unless its key is already indexed (first occurrence wins).
+ *
+ * @param index Index initialised with `kv_index_init()` or built with `kv_index_build()`.
+ * @param entry Entry to add, with offsets relative to `index->str`.
+ * @return `0` if added or already present, or `-1` if the table is full.
+ */
+int kv_index_add(kv_index *index, const kv_index_entry *entry);
+
+/**
+ * @brief Suggests a slot table size for a string.
+ *
+ * @param str Input string containing multiple key-value pairs separated by newline.
+ * @return A power of two of at least twice the number of lines, so the table cannot fill up.
+ */
+size_t kv_index_slot_count(const char *str);
+
+/**
+ * @brief Suggests a slot table size for a length delimited buffer.
+ *
+ * @param str Input buffer containing multiple key-value pairs separated by newline.
+ * @param len Length of `str`.
+ * @return A power of two of at least twice the number of lines, so the table cannot fill up.
+ */
+size_t kv_index_slot_count_n(const char *str, size_t len);
+
+/**
+ * @brief Finds the index entry for a key.
+ *
+ * @param index Index built with `kv_index_build()`.
+ * @param key The key to search for.
+ * @return The matching entry, or `NULL` if the key is not found.
+ */
+const kv_index_entry *kv_index_find(const kv_index *index, const char *key);
+
+/**
+ * @brief Finds the index entry for a key whose length and hash are already known.
+ *
+ * @param index Index built with `kv_index_build()`.
+ * @param key Key characters. Need not be NUL terminated.
+ * @param key_len Length of the key.
+ * @param hash `kv_index_hash()` of the key.
+ * @return The matching entry, or `NULL` if the key is not found.
+ */
+const kv_index_entry *kv_index_find_hashed(const kv_index *index, const char *key, size_t key_len, unsigned int hash);
+
+/**
+ * @brief Gets the value for a key from a hash index.
+ *
+ * @param index Index built with `kv_index_build()`.
+ * @param key The key to search for.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_index_get_value(const kv_index *index, const char *key, char *value, unsigned int value_max);
+#endif
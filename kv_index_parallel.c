@@ -0,0 +1,191 @@
+/**
+ * @file kv_index_parallel.c
+ * @brief Multithreaded hash index build for very large key-value buffers.
+ *
+ * This file contains a function that splits a formatted key-value buffer (e.g., "key=value" or "key: value")
+ * at newline boundaries, indexes each chunk on its own thread and merges the results into one `kv_index`.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_index_parallel.h"
+#include "kv_scan.h"
+#include <pthread.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Slot is being written by one thread. Kept out of the way of the `KV_VALUE_*` flags and `KV_INDEX_SLOT_USED`. */
+#define KV_INDEX_SLOT_BUSY 0x40u
+
+/* One chunk of the input, indexed into the shared table */
+typedef struct
+{
+    kv_index *index;
+    const char *str;
+    size_t len;
+    int *failed;
+} kv_index_chunk;
+
+/*
+ * Adds an entry to a table shared with other threads. Slots are claimed with a compare and swap on their flags, and
+ * a slot being written is marked busy. Of two entries with the same key, the one earliest in the string wins, so the
+ * result does not depend on which thread gets there first.
+ */
+static int kv_index_add_shared(kv_index *index, const kv_index_entry *add)
+{
+    const size_t mask = index->slot_count - 1;
+    size_t slot = add->hash & mask;
+    for (;;)
+    {
+        kv_index_entry *entry = &index->slots[slot];
+        unsigned int flags = __atomic_load_n(&entry->flags, __ATOMIC_ACQUIRE);
+        if (flags & KV_INDEX_SLOT_BUSY)
+        {
+            /* Another thread is writing this slot. Wait for it. */
+            continue;
+        }
+
+        if (!(flags & KV_INDEX_SLOT_USED))
+        {
+            if (!__atomic_compare_exchange_n(&entry->flags, &flags, KV_INDEX_SLOT_BUSY, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                continue;
+            }
+
+            /* Always leave one empty slot so lookups of missing keys terminate */
+            if (__atomic_add_fetch(&index->count, 1, __ATOMIC_RELAXED) >= index->slot_count)
+            {
+                __atomic_sub_fetch(&index->count, 1, __ATOMIC_RELAXED);
+                __atomic_store_n(&entry->flags, 0, __ATOMIC_RELEASE);
+                return -1;
+            }
+            entry->key_offset = add->key_offset;
+            entry->key_len = add->key_len;
+            entry->value_offset = add->value_offset;
+            entry->value_len = add->value_len;
+            entry->hash = add->hash;
+            __atomic_store_n(&entry->flags, add->flags | KV_INDEX_SLOT_USED, __ATOMIC_RELEASE);
+            return 0;
+        }
+
+        /* The hash and key length of a used slot never change, so they can be compared without claiming it */
+        if (entry->hash == add->hash && entry->key_len == add->key_len)
+        {
+            if (!__atomic_compare_exchange_n(&entry->flags, &flags, flags | KV_INDEX_SLOT_BUSY, 0, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+            {
+                continue;
+            }
+
+            const int same = memcmp(index->str + entry->key_offset, index->str + add->key_offset, add->key_len) == 0;
+            if (same && add->key_offset < entry->key_offset)
+            {
+                /* Duplicate Key. First occurrence wins. */
+                entry->key_offset = add->key_offset;
+                entry->value_offset = add->value_offset;
+                entry->value_len = add->value_len;
+                flags = add->flags | KV_INDEX_SLOT_USED;
+            }
+            __atomic_store_n(&entry->flags, flags, __ATOMIC_RELEASE);
+            if (same)
+            {
+                return 0;
+            }
+        }
+
+        slot = (slot + 1) & mask;
+    }
+}
+
+static void *kv_index_chunk_build(void *arg)
+{
+    kv_index_chunk *chunk = arg;
+    kv_index *index = chunk->index;
+    const char *end = chunk->str + chunk->len;
+    for (const char *line = chunk->str; line < end && !__atomic_load_n(chunk->failed, __ATOMIC_RELAXED);)
+    {
+        kv_pair pair;
+        line = kv_scan_pair(line, end, &pair);
+        if (pair.key == NULL)
+        {
+            continue;
+        }
+
+        kv_index_entry entry;
+        entry.key_offset = pair.key - index->str;
+        entry.key_len = pair.key_len;
+        entry.value_offset = pair.value - index->str;
+        entry.value_len = pair.value_len;
+        entry.hash = kv_index_hash(pair.key, pair.key_len);
+        entry.flags = pair.flags;
+        if (kv_index_add_shared(index, &entry) != 0)
+        {
+            __atomic_store_n(chunk->failed, 1, __ATOMIC_RELAXED);
+        }
+    }
+    return NULL;
+}
+
+int kv_index_build_parallel(kv_index *index, const char *str, size_t len, kv_index_entry *slots, size_t slot_count, unsigned int threads)
+{
+    if (threads <= 1 || len < threads)
+    {
+        return kv_index_build_n(index, str, len, slots, slot_count);
+    }
+
+    if (kv_index_init(index, str, slots, slot_count) != 0)
+    {
+        return -1;
+    }
+
+    kv_index_chunk *chunks = calloc(threads, sizeof(*chunks));
+    pthread_t *workers = calloc(threads, sizeof(*workers));
+    if (chunks == NULL || workers == NULL)
+    {
+        free(chunks);
+        free(workers);
+        return -1;
+    }
+
+    /* Split at newline boundaries */
+    int failed = 0;
+    const char *start = str;
+    const char *end = str + len;
+    for (unsigned int t = 0; t < threads; t++)
+    {
+        const char *split = t + 1 == threads ? end : str + len / threads * (t + 1);
+        if (split < start)
+        {
+            split = start;
+        }
+        if (split < end)
+        {
+            const char *eol = memchr(split, '\n', end - split);
+            split = eol ? eol + 1 : end;
+        }
+        chunks[t].index = index;
+        chunks[t].str = start;
+        chunks[t].len = split - start;
+        chunks[t].failed = &failed;
+        start = split;
+    }
+
+    /* Index every chunk into the shared table. The calling thread takes the first one. */
+    unsigned int started = 1;
+    for (; started < threads; started++)
+    {
+        if (pthread_create(&workers[started], NULL, kv_index_chunk_build, &chunks[started]) != 0)
+        {
+            failed = 1;
+            break;
+        }
+    }
+    kv_index_chunk_build(&chunks[0]);
+    for (unsigned int t = 1; t < started; t++)
+    {
+        pthread_join(workers[t], NULL);
+    }
+
+    free(chunks);
+    free(workers);
+    return failed ? -1 : 0;
+}
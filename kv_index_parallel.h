@@ -0,0 +1,41 @@
+/**
+ * @file kv_index_parallel.h
+ * @brief Multithreaded hash index build for very large key-value buffers.
+ *
+ * This file contains a function that splits a formatted key-value buffer (e.g., "key=value" or "key: value")
+ * at newline boundaries, indexes each chunk on its own thread and merges the results into one `kv_index`.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_index_parallel_H
+#define kv_index_parallel_H
+#include "kv_index.h"
+
+/**
+ * @brief Parses a key-value buffer into a hash index using several threads.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * The buffer is split into `threads` chunks at newline boundaries. Every thread indexes its chunk straight into the
+ * caller's table with the same rules as `kv_index_build()`, claiming slots atomically, so there is no serial merge and
+ * no extra table. Of duplicate keys the earliest in the buffer wins, as with `kv_index_build_n()`, so lookups give the
+ * same results; only the slots the keys land in may differ.
+ *
+ * @param index Index to initialise.
+ * @param str Input buffer containing multiple key-value pairs separated by newline. Need not be NUL terminated.
+ * @param len Length of `str`.
+ * @param slots Slot table storage. Should have room for about twice the number of distinct keys.
+ * @param slot_count Number of entries in `slots`. Must be a power of two.
+ * @param threads Number of worker threads. `1` indexes on the calling thread.
+ * @return `0` on success, or `-1` if the table is too small, memory could not be allocated or a thread could not be started.
+ *
+ * @example Usage Example:
+ * @code
+ * size_t slot_count = kv_index_slot_count(data);
+ * kv_index_entry *slots = malloc(slot_count * sizeof(*slots));
+ * kv_index index;
+ * kv_index_build_parallel(&index, data, strlen(data), slots, slot_count, 8);
+ * @endcode
+ */
+int kv_index_build_parallel(kv_index *index, const char *str, size_t len, kv_index_entry *slots, size_t slot_count, unsigned int threads);
+#endif
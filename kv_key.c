@@ -0,0 +1,283 @@
+/**
+ * @file kv_key.c
+ * @brief Precompiled key matchers for repeated lookups of the same keys.
+ *
+ * This file contains functions that prepare a key once (its length, first word and hash) and then
+ * find it in formatted key-value strings or files (e.g., "key=value" or "key: value"), rejecting
+ * non matching lines with a word sized compare instead of walking the key byte by byte.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_key.h"
+#include "kv_scan.h"
+#include <string.h>
+
+#if !defined(KV_PARSE_DISABLE_SIMD) && defined(__GNUC__)
+/*
+ * Whole word loads from the searched string. A word may run past the end of the string, so loads
+ * are only made when they cannot cross a page boundary, as with the vectorised search in kv_get_value.c.
+ */
+#define KV_KEY_WORD_LOADS
+#define KV_KEY_WORD_SAFE(p) (((uintptr_t)(p) & 4095) <= 4096 - sizeof(uint64_t))
+#endif
+
+kv_key kv_key_compile(const char *key)
+{
+    kv_key compiled;
+    compiled.key = key;
+    compiled.len = strlen(key);
+    compiled.hash = kv_index_hash(key, compiled.len);
+
+    const size_t head = compiled.len < sizeof(uint64_t) ? compiled.len : sizeof(uint64_t);
+    unsigned char prefix[sizeof(uint64_t)] = {0};
+    unsigned char mask[sizeof(uint64_t)] = {0};
+    memcpy(prefix, key, head);
+    memset(mask, 0xFF, head);
+    memcpy(&compiled.prefix, prefix, sizeof(prefix));
+    memcpy(&compiled.prefix_mask, mask, sizeof(mask));
+    return compiled;
+}
+
+/* Returns 1 if the line at `str` starts with the key. Never reads past the NUL terminator except within a word that cannot fault. */
+static int kv_key_match(const char *str, const kv_key *key)
+{
+    size_t i = 0;
+#ifdef KV_KEY_WORD_LOADS
+    if (KV_KEY_WORD_SAFE(str))
+    {
+        /* The key holds no NUL, so a string that ends early mismatches within this word */
+        uint64_t word;
+        memcpy(&word, str, sizeof(word));
+        if (((word ^ key->prefix) & key->prefix_mask) != 0)
+        {
+            return 0;
+        }
+        i = key->len < sizeof(uint64_t) ? key->len : sizeof(uint64_t);
+
+        while (i + sizeof(uint64_t) <= key->len && KV_KEY_WORD_SAFE(str + i))
+        {
+            uint64_t key_word;
+            memcpy(&word, str + i, sizeof(word));
+            memcpy(&key_word, key->key + i, sizeof(key_word));
+            if (word != key_word)
+            {
+                return 0;
+            }
+            i += sizeof(uint64_t);
+        }
+    }
+#endif
+
+    for (; i < key->len; i++)
+    {
+        if (str[i] != key->key[i])
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+unsigned int kv_get_value_k(const char *str, const kv_key *key, char *value, unsigned int value_max)
+{
+    while (*str != '\0')
+    {
+        const char *line = str;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (*str == ' ' || *str == '\t')
+        {
+            str++;
+        }
+#endif
+
+        const char *eol = strchr(str, '\n');
+        if (kv_key_match(str, key))
+        {
+            /* Key Prefix Matched. Confirm it with the same rules as kv_get_value(), so keys holding a delimiter match too. */
+            kv_pair pair;
+            if (kv_scan_find(line, eol, key->key, &pair))
+            {
+                return kv_scan_unescape(pair.value, pair.value_len, pair.flags, value, value_max);
+            }
+        }
+
+        /* Key Mismatched. Skip Line */
+        if (eol == NULL)
+        {
+            break;
+        }
+        str = eol + 1;
+    }
+
+    /* End of string. Key was not found. */
+    if (value_max > 0)
+    {
+        value[0] = '\0';
+    }
+    return 0;
+}
+
+/* Copies the value from `file` into `value` using the same rules as kv_file_get_value(). */
+static unsigned int kv_key_file_copy(FILE *file, int ch, char *value, unsigned int value_max)
+{
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    int quote = EOF;
+    int prev = EOF;
+#endif
+    unsigned int i = 0;
+    for (; ch != EOF && ch != '\r' && ch != '\n'; ch = getc(file))
+    {
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        if (quote == EOF && (ch == '\'' || ch == '"'))
+        {
+            /* Start Of Quoted String */
+            quote = ch;
+            prev = ch;
+            continue;
+        }
+        else if (quote != EOF && prev != '\\' && ch == quote)
+        {
+            /* End Of Quoted String */
+            break;
+        }
+        else if (quote != EOF && prev == '\\' && ch == quote)
+        {
+            /* Escaped Character In Quoted String */
+            value[i - 1] = ch;
+            prev = ch;
+            continue;
+        }
+
+        prev = ch;
+#endif
+
+        if (i + 1 >= value_max)
+        {
+            /* Value too large for buffer. Don't return a value. */
+            value[0] = '\0';
+            return 0;
+        }
+        value[i++] = ch;
+    }
+
+    value[i] = '\0';
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    if (ch == EOF || ch == '\r' || ch == '\n')
+    {
+        /* End Of Line. Trim trailing whitespace. */
+        while (i > 0 && (value[i - 1] == ' ' || value[i - 1] == '\t'))
+        {
+            i--;
+            value[i] = '\0';
+        }
+    }
+#endif
+    return i;
+}
+
+unsigned int kv_file_get_value_k(FILE *file, const kv_key *key, char *value, unsigned int value_max)
+{
+    if (value_max > 0)
+    {
+        value[0] = '\0';
+    }
+
+    rewind(file);
+
+    for (int ch = getc(file); ch != EOF; ch = getc(file))
+    {
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Check First Word Of Key */
+        const size_t head = key->len < sizeof(uint64_t) ? key->len : sizeof(uint64_t);
+        unsigned char bytes[sizeof(uint64_t)] = {0};
+        size_t i = 0;
+        for (; i < head && ch != EOF && ch != '\n'; i++, ch = getc(file))
+        {
+            bytes[i] = (unsigned char)ch;
+        }
+        uint64_t word;
+        memcpy(&word, bytes, sizeof(word));
+        if (i < head || ((word ^ key->prefix) & key->prefix_mask) != 0)
+        {
+            goto skip_line;
+        }
+
+        /* Check Rest Of Key */
+        for (; i < key->len; i++, ch = getc(file))
+        {
+            if (ch != (unsigned char)key->key[i])
+            {
+                goto skip_line;
+            }
+        }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Check For Key Value Delimiter */
+        if (ch != '=' && ch != ':')
+        {
+            goto skip_line;
+        }
+        ch = getc(file);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        if (value_max == 0)
+        {
+            return 0;
+        }
+        return kv_key_file_copy(file, ch, value, value_max);
+
+    skip_line:
+        /* Search for start of next line */
+        while (ch != '\n')
+        {
+            if (ch == EOF)
+            {
+                /* End of file. Key was not found. */
+                return 0;
+            }
+            ch = getc(file);
+        }
+    }
+
+    /* End of file. Key was not found. */
+    return 0;
+}
+
+const kv_index_entry *kv_index_find_k(const kv_index *index, const kv_key *key)
+{
+    return kv_index_find_hashed(index, key->key, key->len, key->hash);
+}
+
+unsigned int kv_index_get_value_k(const kv_index *index, const kv_key *key, char *value, unsigned int value_max)
+{
+    const kv_index_entry *entry = kv_index_find_k(index, key);
+    if (entry == NULL)
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    return kv_scan_unescape(index->str + entry->value_offset, entry->value_len, entry->flags & ~KV_INDEX_SLOT_USED, value, value_max);
+}
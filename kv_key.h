@@ -0,0 +1,100 @@
+/**
+ * @file kv_key.h
+ * @brief Precompiled key matchers for repeated lookups of the same keys.
+ *
+ * This file contains functions that prepare a key once (its length, first word and hash) and then
+ * find it in formatted key-value strings or files (e.g., "key=value" or "key: value"), rejecting
+ * non matching lines with a word sized compare instead of walking the key byte by byte.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_key_H
+#define kv_key_H
+#include "kv_index.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/**
+ * @brief A key prepared for matching.
+ *
+ * Never modified after `kv_key_compile()`, so one matcher can be shared by any number of threads.
+ * Points to the key string, which must outlive it.
+ */
+typedef struct
+{
+    const char *key;      /**< The key string. */
+    size_t len;           /**< Length of the key. */
+    uint64_t prefix;      /**< First (up to) 8 bytes of the key, zero padded, in memory order. */
+    uint64_t prefix_mask; /**< Selects the bytes of `prefix` that belong to the key. */
+    unsigned int hash;    /**< `kv_index_hash()` of the key, for `kv_index_find_k()`. */
+} kv_key;
+
+/**
+ * @brief Prepares a key for repeated lookups.
+ *
+ * @param key The key to prepare. Must outlive the returned matcher.
+ * @return The compiled matcher.
+ */
+kv_key kv_key_compile(const char *key);
+
+/**
+ * @brief Parses a key-value pair from a given string with a compiled key.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Applies the same rules as `kv_get_value()`. Each line is first checked against the key's first word,
+ * so most non matching lines are rejected with one compare.
+ *
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param key Key compiled with `kv_key_compile()`.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ *
+ * @example Usage Example:
+ * @code
+ * static const char *names[] = {"username", "password"};
+ * kv_key keys[2] = {kv_key_compile(names[0]), kv_key_compile(names[1])};
+ * char buffer[50];
+ * for (size_t d = 0; d < ndocs; d++) {
+ *     unsigned int len = kv_get_value_k(docs[d], &keys[0], buffer, sizeof(buffer));
+ * }
+ * @endcode
+ */
+unsigned int kv_get_value_k(const char *str, const kv_key *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Parses a key-value pair from a file stream with a compiled key.
+ *
+ * Applies the same rules as `kv_file_get_value()`, except that a line that starts with the key but has no
+ * delimiter after it is skipped rather than ending the search.
+ *
+ * @param file File stream to read from. Rewound before the search.
+ * @param key Key compiled with `kv_key_compile()`.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_file_get_value_k(FILE *file, const kv_key *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Finds the index entry for a compiled key, without rehashing it.
+ *
+ * @param index Index built with `kv_index_build()`.
+ * @param key Key compiled with `kv_key_compile()`.
+ * @return The matching entry, or `NULL` if the key is not found.
+ */
+const kv_index_entry *kv_index_find_k(const kv_index *index, const kv_key *key);
+
+/**
+ * @brief Gets the value for a compiled key from a hash index.
+ *
+ * @param index Index built with `kv_index_build()`.
+ * @param key Key compiled with `kv_key_compile()`.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_index_get_value_k(const kv_index *index, const kv_key *key, char *value, unsigned int value_max);
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file kv_keys.c
+ * @brief Sorted key array for prefix queries and range scans.
+ *
+ * This file contains functions that parse a formatted key-value string (e.g., "key=value" or "key: value")
+ * once into an array of pairs sorted by key, so that every key under a prefix or within a range can be
+ * found with a binary search.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_keys.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Orders by key bytes, then by position in the string so the first occurrence sorts first */
+static int kv_keys_order(const void *a, const void *b)
+{
+    const kv_pair *pa = a;
+    const kv_pair *pb = b;
+    const size_t n = pa->key_len < pb->key_len ? pa->key_len : pb->key_len;
+    const int cmp = memcmp(pa->key, pb->key, n);
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    if (pa->key_len != pb->key_len)
+    {
+        return pa->key_len < pb->key_len ? -1 : 1;
+    }
+    return pa->key < pb->key ? -1 : pa->key > pb->key;
+}
+
+/* Compares a pair's key with `key`, looking only at the first `key_len` bytes when `prefix` is set */
+static int kv_keys_compare(const kv_pair *pair, const char *key, size_t key_len, int prefix)
+{
+    const size_t n = pair->key_len < key_len ? pair->key_len : key_len;
+    const int cmp = memcmp(pair->key, key, n);
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    if (pair->key_len < key_len)
+    {
+        return -1;
+    }
+    return prefix ? 0 : pair->key_len > key_len;
+}
+
+/* Returns the first pair whose comparison with `key` is at least `bound` (0 for lower bound, 1 for upper bound) */
+static size_t kv_keys_search(const kv_keys *keys, const char *key, int prefix, int bound)
+{
+    const size_t key_len = strlen(key);
+    size_t lo = 0;
+    size_t hi = keys->count;
+    while (lo < hi)
+    {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (kv_keys_compare(&keys->pairs[mid], key, key_len, prefix) < bound)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+size_t kv_keys_max(const char *str)
+{
+    size_t lines = 1;
+    for (str = strchr(str, '\n'); str != NULL; str = strchr(str + 1, '\n'))
+    {
+        lines++;
+    }
+    return lines;
+}
+
+int kv_keys_build(kv_keys *keys, const char *str, kv_pair *pairs, size_t pairs_max)
+{
+    keys->str = str;
+    keys->pairs = pairs;
+    keys->count = 0;
+
+    while (*str != '\0')
+    {
+        kv_pair pair;
+        str = kv_scan_pair(str, NULL, &pair);
+        if (pair.key == NULL)
+        {
+            continue;
+        }
+
+        if (keys->count >= pairs_max)
+        {
+            return -1;
+        }
+        pairs[keys->count++] = pair;
+    }
+
+    qsort(pairs, keys->count, sizeof(*pairs), kv_keys_order);
+
+    /* Duplicate Keys. First occurrence wins, and sorts first. */
+    size_t count = 0;
+    for (size_t i = 0; i < keys->count; i++)
+    {
+        if (count > 0 && pairs[count - 1].key_len == pairs[i].key_len && memcmp(pairs[count - 1].key, pairs[i].key, pairs[i].key_len) == 0)
+        {
+            continue;
+        }
+        pairs[count++] = pairs[i];
+    }
+    keys->count = count;
+    return 0;
+}
+
+size_t kv_keys_prefix(const kv_keys *keys, const char *prefix, const kv_pair **first)
+{
+    const size_t lo = kv_keys_search(keys, prefix, 1, 0);
+    const size_t hi = kv_keys_search(keys, prefix, 1, 1);
+    *first = keys->pairs + lo;
+    return hi - lo;
+}
+
+size_t kv_keys_range(const kv_keys *keys, const char *from, const char *to, const kv_pair **first)
+{
+    const size_t lo = from ? kv_keys_search(keys, from, 0, 0) : 0;
+    const size_t hi = to ? kv_keys_search(keys, to, 0, 0) : keys->count;
+    *first = keys->pairs + lo;
+    return hi > lo ? hi - lo : 0;
+}
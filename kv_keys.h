@@ -0,0 +1,90 @@
+/**
+ * @file kv_keys.h
+ * @brief Sorted key array for prefix queries and range scans.
+ *
+ * This file contains functions that parse a formatted key-value string (e.g., "key=value" or "key: value")
+ * once into an array of pairs sorted by key, so that every key under a prefix or within a range can be
+ * found with a binary search.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_keys_H
+#define kv_keys_H
+#include "kv_scan.h"
+#include <stddef.h>
+
+/**
+ * @brief Pairs of a key-value string sorted by key.
+ *
+ * The parsed string and the pair storage are owned by the caller and must outlive the array.
+ */
+typedef struct
+{
+    const char *str; /**< Parsed string. */
+    kv_pair *pairs;  /**< Caller provided pairs, sorted by key in byte order. One per distinct key. */
+    size_t count;    /**< Number of distinct keys. */
+} kv_keys;
+
+/**
+ * @brief Counts the pairs a key array may need for a string.
+ *
+ * @param str Input string containing multiple key-value pairs separated by newline.
+ * @return The number of lines, which bounds the number of keys.
+ */
+size_t kv_keys_max(const char *str);
+
+/**
+ * @brief Parses a key-value string once into an array sorted by key.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Lines are parsed with the same rules as `kv_get_value()`. If a key appears more than once, the first
+ * occurrence is kept. No memory is allocated; pairs live in the caller provided `pairs` storage.
+ * Values are slices of `str`; use `kv_scan_unescape()` to copy one out.
+ *
+ * @param keys Array to initialise.
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param pairs Pair storage. `kv_keys_max()` entries are always enough.
+ * @param pairs_max Number of entries in `pairs`.
+ * @return `0` on success, or `-1` if `pairs` is too small.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_pair pairs[64];
+ * kv_keys keys;
+ * const kv_pair *first;
+ * if (kv_keys_build(&keys, environ_text, pairs, 64) == 0) {
+ *     size_t n = kv_keys_prefix(&keys, "XDG_", &first);
+ *     for (size_t i = 0; i < n; i++) {
+ *         printf("%.*s\n", (int)first[i].key_len, first[i].key);
+ *     }
+ * }
+ * @endcode
+ */
+int kv_keys_build(kv_keys *keys, const char *str, kv_pair *pairs, size_t pairs_max);
+
+/**
+ * @brief Finds every key that starts with a prefix.
+ *
+ * Costs O(log n) to locate the result; the matching pairs are contiguous and already in key order.
+ *
+ * @param keys Array built with `kv_keys_build()`.
+ * @param prefix The prefix to match. `""` matches every key.
+ * @param first Output pointer to the first matching pair.
+ * @return The number of matching pairs.
+ */
+size_t kv_keys_prefix(const kv_keys *keys, const char *prefix, const kv_pair **first);
+
+/**
+ * @brief Finds every key in the half open range [`from`, `to`) in byte order.
+ *
+ * Costs O(log n) to locate the result; the matching pairs are contiguous and already in key order.
+ *
+ * @param keys Array built with `kv_keys_build()`.
+ * @param from Lowest key included, or `NULL` to start at the first key.
+ * @param to Lowest key excluded, or `NULL` to end after the last key.
+ * @param first Output pointer to the first matching pair.
+ * @return The number of matching pairs.
+ */
+size_t kv_keys_range(const kv_keys *keys, const char *from, const char *to, const kv_pair **first);
+#endif
@@ -0,0 +1,104 @@
+/**
+ * @file kv_mapped_file.c
+ * @brief Memory mapped key-value file lookups.
+ *
+ * This file contains functions that map a formatted key-value file (e.g., "key=value" or "key: value")
+ * into memory and extract values straight from the mapped bytes, without per character stdio reads.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include "kv_mapped_file.h"
+#include "kv_scan.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+int kv_mapped_file_open(kv_mapped_file *mapped, const char *path)
+{
+    mapped->data = NULL;
+    mapped->size = 0;
+
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+
+    const int result = kv_mapped_file_open_fd(mapped, fd);
+    close(fd);
+    return result;
+}
+
+int kv_mapped_file_open_fd(kv_mapped_file *mapped, int fd)
+{
+    mapped->data = NULL;
+    mapped->size = 0;
+
+    struct stat st;
+    if (fstat(fd, &st) != 0)
+    {
+        return -1;
+    }
+
+    if (st.st_size == 0)
+    {
+        /* Empty file. Nothing to map. */
+        return 0;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED)
+    {
+        return -1;
+    }
+
+    mapped->data = data;
+    mapped->size = (size_t)st.st_size;
+    return 0;
+}
+
+void kv_mapped_file_close(kv_mapped_file *mapped)
+{
+    if (mapped->data != NULL)
+    {
+        munmap((void *)mapped->data, mapped->size);
+    }
+    mapped->data = NULL;
+    mapped->size = 0;
+}
+
+unsigned int kv_mapped_file_get_value(const kv_mapped_file *mapped, const char *key, char *value, unsigned int value_max)
+{
+    kv_pair pair;
+    if (mapped->data == NULL || !kv_scan_find(mapped->data, mapped->data + mapped->size, key, &pair))
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    return kv_scan_unescape(pair.value, pair.value_len, pair.flags, value, value_max);
+}
+
+unsigned int kv_path_get_value(const char *path, const char *key, char *value, unsigned int value_max)
+{
+    kv_mapped_file mapped;
+    if (kv_mapped_file_open(&mapped, path) != 0)
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    const unsigned int len = kv_mapped_file_get_value(&mapped, key, value, value_max);
+    kv_mapped_file_close(&mapped);
+    return len;
+}
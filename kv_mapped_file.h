@@ -0,0 +1,90 @@
+/**
+ * @file kv_mapped_file.h
+ * @brief Memory mapped key-value file lookups.
+ *
+ * This file contains functions that map a formatted key-value file (e.g., "key=value" or "key: value")
+ * into memory and extract values straight from the mapped bytes, without per character stdio reads.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_mapped_file_H
+#define kv_mapped_file_H
+#include <stddef.h>
+
+/**
+ * @brief Read only memory mapping of a key-value file.
+ *
+ * The mapped bytes are not NUL terminated and the last line need not end with a newline.
+ */
+typedef struct
+{
+    const char *data; /**< Mapped file contents, or `NULL` for an empty file. */
+    size_t size;      /**< Size of the file in bytes. */
+} kv_mapped_file;
+
+/**
+ * @brief Maps a key-value file into memory.
+ *
+ * @param mapped Handle to initialise.
+ * @param path Path of the key-value file.
+ * @return `0` on success, or `-1` if the file could not be opened or mapped.
+ */
+int kv_mapped_file_open(kv_mapped_file *mapped, const char *path);
+
+/**
+ * @brief Maps an already open key-value file into memory.
+ *
+ * Lets the caller `fstat()` the same descriptor, so the metadata it records describes the mapped bytes.
+ * The descriptor stays open and owned by the caller; the mapping outlives it.
+ *
+ * @param mapped Handle to initialise.
+ * @param fd Descriptor of the key-value file, open for reading.
+ * @return `0` on success, or `-1` if the file could not be mapped.
+ */
+int kv_mapped_file_open_fd(kv_mapped_file *mapped, int fd);
+
+/**
+ * @brief Unmaps a key-value file mapped with `kv_mapped_file_open()`.
+ *
+ * @param mapped Handle to release.
+ */
+void kv_mapped_file_close(kv_mapped_file *mapped);
+
+/**
+ * @brief Parses a key-value pair from a mapped file.
+ *
+ * Applies the same rules as `kv_get_value()`. Each lookup scans the mapped bytes directly, with no copies and no system calls.
+ *
+ * @param mapped Handle opened with `kv_mapped_file_open()`.
+ * @param key The key to search for in the mapped file.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_mapped_file_get_value(const kv_mapped_file *mapped, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Parses a key-value pair from the file at a given path.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Maps the file, looks up the key with the same rules as `kv_get_value()`, then unmaps it.
+ * Keep a `kv_mapped_file` open instead when looking up several keys from the same file.
+ *
+ * @param path Path of the key-value file.
+ * @param key The key to search for in the file.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found, does not fit or the file cannot be read.
+ *
+ * @example Usage Example:
+ * @code
+ * char buffer[50];
+ * unsigned int len = kv_path_get_value("/etc/os-release", "ID", buffer, sizeof(buffer));
+ * if (len > 0) {
+ *     printf("ID: %s\n", buffer);
+ * }
+ * @endcode
+ */
+unsigned int kv_path_get_value(const char *path, const char *key, char *value, unsigned int value_max);
+#endif
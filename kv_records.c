@@ -0,0 +1,58 @@
+/**
+ * @file kv_records.c
+ * @brief Key-value lookups over length delimited buffers with configurable record separators.
+ *
+ * This file contains functions that find a key in a buffer of key-value records (e.g., "key=value" or "key: value")
+ * separated by any of a caller chosen set of characters, such as the NUL separated `/proc/<pid>/environ` or `env -0` output.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_records.h"
+#include "kv_scan.h"
+#include <string.h>
+
+#define KV_RECORDS_IS_SEP(seps, c) ((seps)->is_separator[(unsigned char)(c)])
+
+void kv_separators_init(kv_separators *seps, const char *chars, size_t nchars)
+{
+    memset(seps->is_separator, 0, sizeof(seps->is_separator));
+    seps->count = 0;
+    seps->single = '\0';
+    for (size_t i = 0; i < nchars; i++)
+    {
+        if (!KV_RECORDS_IS_SEP(seps, chars[i]))
+        {
+            seps->is_separator[(unsigned char)chars[i]] = 1;
+            seps->count++;
+            seps->single = chars[i];
+        }
+    }
+}
+
+kv_value_view kv_get_value_view_sep(const char *str, size_t len, const kv_separators *seps, const char *key)
+{
+    kv_value_view view = {NULL, 0, 0};
+    kv_pair pair;
+    if (kv_scan_find_sep(str, str + len, seps, key, &pair))
+    {
+        view.ptr = pair.value;
+        view.len = pair.value_len;
+        view.flags = pair.flags;
+    }
+    return view;
+}
+
+unsigned int kv_get_value_sep(const char *str, size_t len, const kv_separators *seps, const char *key, char *value, unsigned int value_max)
+{
+    const kv_value_view view = kv_get_value_view_sep(str, len, seps, key);
+    if (view.ptr == NULL)
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+    return kv_scan_unescape(view.ptr, view.len, view.flags, value, value_max);
+}
@@ -0,0 +1,78 @@
+/**
+ * @file kv_records.h
+ * @brief Key-value lookups over length delimited buffers with configurable record separators.
+ *
+ * This file contains functions that find a key in a buffer of key-value records (e.g., "key=value" or "key: value")
+ * separated by any of a caller chosen set of characters, such as the NUL separated `/proc/<pid>/environ` or `env -0` output.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_records_H
+#define kv_records_H
+#include "kv_get_value_view.h"
+#include "kv_scan.h"
+#include <stddef.h>
+
+/**
+ * @brief Initialises a record separator set.
+ *
+ * @param seps Set to initialise.
+ * @param chars Separator characters. May contain `'\0'`, hence the explicit length.
+ * @param nchars Number of characters in `chars`.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_separators environ_seps, line_seps;
+ * kv_separators_init(&environ_seps, "\0", 1);
+ * kv_separators_init(&line_seps, "\r\n", 2);
+ * @endcode
+ */
+void kv_separators_init(kv_separators *seps, const char *chars, size_t nchars);
+
+/**
+ * @brief Locates a key-value pair in a length delimited buffer without copying.
+ *
+ * Applies the same key, delimiter, whitespace and quote rules as `kv_get_value()`, but records end at any character in
+ * `seps` instead of at `'\r'` or `'\n'`, and the buffer ends after `len` bytes instead of at a NUL terminator.
+ * Only the first delimiter splits a record, so `"A=B=C"` has the value `"B=C"`.
+ *
+ * @param str Input buffer containing multiple key-value records. Need not be NUL terminated.
+ * @param len Length of `str`.
+ * @param seps Record separators.
+ * @param key The key to search for.
+ * @return View of the value, as with `kv_get_value_view()`. `ptr` is `NULL` if the key is not found.
+ */
+kv_value_view kv_get_value_view_sep(const char *str, size_t len, const kv_separators *seps, const char *key);
+
+/**
+ * @brief Parses a key-value record from a length delimited buffer with configurable record separators.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Same as `kv_get_value_view_sep()`, but copies the value out with quotes resolved.
+ *
+ * @param str Input buffer containing multiple key-value records. Need not be NUL terminated.
+ * @param len Length of `str`.
+ * @param seps Record separators.
+ * @param key The key to search for.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ *
+ * @example Usage Example:
+ * @code
+ * char env_buf[4096], path[256];
+ * FILE *file = fopen("/proc/self/environ", "r");
+ * if (file != NULL) {
+ *     size_t len = fread(env_buf, 1, sizeof(env_buf), file);
+ *     fclose(file);
+ *     kv_separators seps;
+ *     kv_separators_init(&seps, "\0", 1);
+ *     if (kv_get_value_sep(env_buf, len, &seps, "PATH", path, sizeof(path)) > 0) {
+ *         printf("PATH: %s\n", path);
+ *     }
+ * }
+ * @endcode
+ */
+unsigned int kv_get_value_sep(const char *str, size_t len, const kv_separators *seps, const char *key, char *value, unsigned int value_max);
+#endif
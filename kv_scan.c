@@ -0,0 +1,282 @@
+/**
+ * @file kv_scan.c
+ * @brief Line scanner shared by the indexed and zero-copy key-value lookups.
+ *
+ * This file contains a function that splits one line of a formatted key-value buffer
+ * (e.g., "key=value" or "key: value") into key and value slices without copying. Buffers whose records
+ * end at other characters, such as NUL separated environment blocks, are scanned with a `kv_separators` set.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_scan.h"
+#include <string.h>
+
+#define KV_SCAN_AT_END(p) ((end) ? (p) >= (end) : *(p) == '\0')
+/* Record separators, when records are not lines. A space or tab may itself be a separator. */
+#define KV_SCAN_IS_SEP(seps, c) ((seps) != NULL && (seps)->is_separator[(unsigned char)(c)])
+#define KV_SCAN_IS_BLANK(seps, c) (((c) == ' ' || (c) == '\t') && !KV_SCAN_IS_SEP(seps, c))
+#define KV_SCAN_IS_VALUE_END(seps, c) ((seps) ? KV_SCAN_IS_SEP(seps, c) : ((c) == '\r' || (c) == '\n'))
+
+/* Search for start of next line */
+static const char *kv_scan_skip_line(const char *str, const char *end)
+{
+    if (end)
+    {
+        const char *eol = memchr(str, '\n', end - str);
+        return eol ? eol + 1 : end;
+    }
+
+    const char *eol = strchr(str, '\n');
+    return eol ? eol + 1 : str + strlen(str);
+}
+
+/* Search for start of next record. Lines unless `seps` is given, in which case `end` must be too. */
+static const char *kv_scan_skip_record(const char *str, const char *end, const kv_separators *seps)
+{
+    if (seps == NULL)
+    {
+        return kv_scan_skip_line(str, end);
+    }
+
+    if (seps->count == 1)
+    {
+        const char *sep = memchr(str, seps->single, end - str);
+        return sep ? sep + 1 : end;
+    }
+
+    while (str < end && !KV_SCAN_IS_SEP(seps, *str))
+    {
+        str++;
+    }
+    return str < end ? str + 1 : end;
+}
+
+/* Finds the value extent at `str` (just past the delimiter and any whitespace) and stores it in `pair`. The value ends at a line end, or at a separator if `seps` is given. */
+static void kv_scan_value(const char *str, const char *end, const kv_separators *seps, kv_pair *pair)
+{
+    const char *value = str;
+    const char *content = str;
+    unsigned int flags = 0;
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    char quote = '\0';
+#endif
+    for (; !KV_SCAN_AT_END(str) && !KV_SCAN_IS_VALUE_END(seps, *str); str++)
+    {
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        if (quote == '\0' && (*str == '\'' || *str == '"'))
+        {
+            /* Start Of Quoted String */
+            quote = *str;
+            flags |= KV_VALUE_QUOTED;
+            if (str == value)
+            {
+                content = str + 1;
+            }
+            else
+            {
+                flags |= KV_VALUE_ESCAPED;
+            }
+        }
+        else if (quote != '\0' && *str == quote)
+        {
+            if (*(str - 1) == '\\')
+            {
+                /* Escaped Quote Character In Quoted String */
+                flags |= KV_VALUE_ESCAPED;
+                continue;
+            }
+
+            /* End Of Quoted String. Trailing whitespace is kept. */
+            pair->value = (flags & KV_VALUE_ESCAPED) ? value : content;
+            pair->value_len = str - pair->value;
+            pair->flags = flags;
+            return;
+        }
+#endif
+    }
+
+    /* End Of Line. Trim trailing whitespace. */
+    const char *value_end = str;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (value_end > content && KV_SCAN_IS_BLANK(seps, value_end[-1]))
+    {
+        value_end--;
+    }
+#endif
+    pair->value = (flags & KV_VALUE_ESCAPED) ? value : content;
+    pair->value_len = value_end - pair->value;
+    pair->flags = flags;
+}
+
+const char *kv_scan_pair(const char *str, const char *end, kv_pair *pair)
+{
+    pair->key = NULL;
+    pair->key_len = 0;
+    pair->value = NULL;
+    pair->value_len = 0;
+    pair->flags = 0;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (!KV_SCAN_AT_END(str) && (*str == ' ' || *str == '\t'))
+    {
+        str++;
+    }
+#endif
+
+    /* Find Key Value Delimiter */
+    const char *key = str;
+    while (!KV_SCAN_AT_END(str) && *str != '=' && *str != ':' && *str != '\n')
+    {
+        str++;
+    }
+
+    if (KV_SCAN_AT_END(str) || *str == '\n')
+    {
+        /* No delimiter on this line. Skip Line */
+        return kv_scan_skip_line(str, end);
+    }
+
+    const char *key_end = str;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (key_end > key && (key_end[-1] == ' ' || key_end[-1] == '\t'))
+    {
+        key_end--;
+    }
+#endif
+    str++;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (!KV_SCAN_AT_END(str) && (*str == ' ' || *str == '\t'))
+    {
+        str++;
+    }
+#endif
+
+    kv_scan_value(str, end, NULL, pair);
+    pair->key = key;
+    pair->key_len = key_end - key;
+    return kv_scan_skip_line(pair->value + pair->value_len, end);
+}
+
+/* Finds the first record whose key matches. Records are lines unless `seps` is given. */
+static int kv_scan_find_in(const char *str, const char *end, const kv_separators *seps, const char *key, kv_pair *pair)
+{
+    const size_t key_len = strlen(key);
+    while (!KV_SCAN_AT_END(str))
+    {
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (!KV_SCAN_AT_END(str) && KV_SCAN_IS_BLANK(seps, *str))
+        {
+            str++;
+        }
+#endif
+
+        /* Check For Key */
+        const char *line_key = str;
+        size_t i = 0;
+        while (i < key_len && !KV_SCAN_AT_END(str) && *str == key[i] && !KV_SCAN_IS_SEP(seps, *str))
+        {
+            i++;
+            str++;
+        }
+
+        if (i != key_len)
+        {
+            /* Key Mismatched. Skip Line */
+            str = kv_scan_skip_record(str, end, seps);
+            continue;
+        }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (!KV_SCAN_AT_END(str) && KV_SCAN_IS_BLANK(seps, *str))
+        {
+            str++;
+        }
+#endif
+
+        /* Check For Key Value Delimiter */
+        if (KV_SCAN_AT_END(str) || (*str != '=' && *str != ':') || KV_SCAN_IS_SEP(seps, *str))
+        {
+            str = kv_scan_skip_record(str, end, seps);
+            continue;
+        }
+        str++;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (!KV_SCAN_AT_END(str) && KV_SCAN_IS_BLANK(seps, *str))
+        {
+            str++;
+        }
+#endif
+
+        kv_scan_value(str, end, seps, pair);
+        pair->key = line_key;
+        pair->key_len = key_len;
+        return 1;
+    }
+
+    /* End of buffer. Key was not found. */
+    pair->key = NULL;
+    pair->key_len = 0;
+    pair->value = NULL;
+    pair->value_len = 0;
+    pair->flags = 0;
+    return 0;
+}
+
+int kv_scan_find(const char *str, const char *end, const char *key, kv_pair *pair)
+{
+    return kv_scan_find_in(str, end, NULL, key, pair);
+}
+
+int kv_scan_find_sep(const char *str, const char *end, const kv_separators *seps, const char *key, kv_pair *pair)
+{
+    return kv_scan_find_in(str, end, seps, key, pair);
+}
+
+unsigned int kv_scan_unescape(const char *raw, size_t raw_len, unsigned int flags, char *value, unsigned int value_max)
+{
+    if (value_max == 0)
+    {
+        return 0;
+    }
+
+    unsigned int i = 0;
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    char quote = '\0';
+#else
+    (void)flags;
+#endif
+    for (size_t n = 0; n < raw_len; n++)
+    {
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        if (flags & KV_VALUE_ESCAPED)
+        {
+            if (quote == '\0' && (raw[n] == '\'' || raw[n] == '"'))
+            {
+                /* Start Of Quoted String */
+                quote = raw[n];
+                continue;
+            }
+            else if (quote != '\0' && n > 0 && raw[n - 1] == '\\' && raw[n] == quote)
+            {
+                /* Escaped Quote Character In Quoted String */
+                value[i - 1] = raw[n];
+                continue;
+            }
+        }
+#endif
+
+        if (i + 1 >= value_max)
+        {
+            /* Value too large for buffer. Don't return a value. */
+            value[0] = '\0';
+            return 0;
+        }
+        value[i++] = raw[n];
+    }
+
+    value[i] = '\0';
+    return i;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file kv_scan.h
+ * @brief Line scanner shared by the indexed and zero-copy key-value lookups.
+ *
+ * This file contains a function that splits one line of a formatted key-value buffer
+ * (e.g., "key=value" or "key: value") into key and value slices without copying. Buffers whose records
+ * end at other characters, such as NUL separated environment blocks, are scanned with a `kv_separators` set.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_scan_H
+#define kv_scan_H
+#include <stddef.h>
+
+/** Value was enclosed in single (`'`) or double (`"`) quotes. */
+#define KV_VALUE_QUOTED 0x01u
+/** Value slice is raw source text that still contains quotes or escaped quotes. Use kv_scan_unescape() to resolve it. */
+#define KV_VALUE_ESCAPED 0x02u
+
+/**
+ * @brief One key-value pair located in the source buffer.
+ *
+ * All pointers point into the scanned buffer. Nothing is NUL terminated.
+ */
+typedef struct
+{
+    const char *key;    /**< Start of the key (leading whitespace skipped), or `NULL` if the line holds no pair. */
+    size_t key_len;     /**< Length of the key (trailing whitespace trimmed). */
+    const char *value;  /**< Start of the value slice. */
+    size_t value_len;   /**< Length of the value slice. */
+    unsigned int flags; /**< `KV_VALUE_QUOTED` and/or `KV_VALUE_ESCAPED`. */
+} kv_pair;
+
+/**
+ * @brief Set of characters that end a record, for buffers that are not split into lines.
+ *
+ * Build once with `kv_separators_init()` (see kv_records.h) and reuse for every lookup.
+ */
+typedef struct
+{
+    unsigned char is_separator[256]; /**< Non zero for each separator character. */
+    unsigned int count;              /**< Number of distinct separator characters. */
+    char single;                     /**< The separator if `count` is `1`, searched for with `memchr()`. */
+} kv_separators;
+
+/**
+ * @brief Scans one line of a key-value buffer.
+ *
+ * Applies the same whitespace, delimiter and quote rules as `kv_get_value()`, including the
+ * `KV_PARSE_DISABLE_WHITESPACE_SKIP` and `KV_PARSE_DISABLE_QUOTED_STRINGS` compile flags.
+ *
+ * @param str Start of the line to scan.
+ * @param end End of the buffer, or `NULL` if the buffer is NUL terminated.
+ * @param pair Output pair. `pair->key` is `NULL` if the line holds no key-value pair.
+ * @return Start of the next line, or the end of the buffer if this was the last line.
+ */
+const char *kv_scan_pair(const char *str, const char *end, kv_pair *pair);
+
+/**
+ * @brief Finds the first line whose key matches and scans its value.
+ *
+ * Applies the same rules as `kv_get_value()`. Non matching lines are skipped with a fast search for the next newline.
+ *
+ * @param str Input buffer containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param end End of the buffer, or `NULL` if the buffer is NUL terminated.
+ * @param key The key to search for.
+ * @param pair Output pair.
+ * @return `1` if the key is found, or `0` if it is not.
+ */
+int kv_scan_find(const char *str, const char *end, const char *key, kv_pair *pair);
+
+/**
+ * @brief Finds the first record whose key matches, with records ending at any character in `seps`.
+ *
+ * Same as `kv_scan_find()`, but records end at a separator instead of at `'\r'` or `'\n'`. Spaces and tabs
+ * that are separators end the record rather than being skipped as whitespace.
+ *
+ * @param str Input buffer containing multiple key-value records. Need not be NUL terminated.
+ * @param end End of the buffer.
+ * @param seps Record separators.
+ * @param key The key to search for.
+ * @param pair Output pair.
+ * @return `1` if the key is found, or `0` if it is not.
+ */
+int kv_scan_find_sep(const char *str, const char *end, const kv_separators *seps, const char *key, kv_pair *pair);
+
+/**
+ * @brief Copies a scanned value slice into a buffer, resolving quotes and escaped quotes.
+ *
+ * @param raw Value slice as returned in `kv_pair::value`.
+ * @param raw_len Value slice length as returned in `kv_pair::value_len`.
+ * @param flags Value flags as returned in `kv_pair::flags`.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator), or `0` if it does not fit.
+ */
+unsigned int kv_scan_unescape(const char *raw, size_t raw_len, unsigned int flags, char *value, unsigned int value_max);
+#endif
@@ -0,0 +1,196 @@
+/**
+ * @file kv_section.c
+ * @brief INI style `[section]` aware key-value lookups.
+ *
+ * This file contains functions that extract values associated with keys inside a named `[section]` of a
+ * formatted key-value string (e.g., "key=value" or "key: value"), and a table of section byte ranges so
+ * repeated lookups only scan the section they need.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_section.h"
+#include "kv_scan.h"
+#include <string.h>
+
+/* Search for start of next line */
+static const char *kv_section_next_line(const char *str)
+{
+    const char *eol = strchr(str, '\n');
+    return eol ? eol + 1 : str + strlen(str);
+}
+
+/* Checks whether the line at `str` is a `[name]` header. Returns 1 and the name slice if it is. */
+static int kv_section_header(const char *str, const char **name, size_t *name_len)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (*str == ' ' || *str == '\t')
+    {
+        str++;
+    }
+#endif
+
+    if (*str != '[')
+    {
+        return 0;
+    }
+    str++;
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (*str == ' ' || *str == '\t')
+    {
+        str++;
+    }
+#endif
+
+    const char *name_start = str;
+    while (*str != '\0' && *str != '\n' && *str != ']')
+    {
+        str++;
+    }
+
+    if (*str != ']')
+    {
+        /* Unterminated header. Not a section. */
+        return 0;
+    }
+
+    const char *name_end = str;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (name_end > name_start && (name_end[-1] == ' ' || name_end[-1] == '\t'))
+    {
+        name_end--;
+    }
+#endif
+    *name = name_start;
+    *name_len = name_end - name_start;
+    return 1;
+}
+
+/* Compares a section name slice against the requested section. `NULL` selects the global section. */
+static int kv_section_name_equal(const char *name, size_t name_len, const char *section)
+{
+    if (section == NULL)
+    {
+        return name_len == 0;
+    }
+    return strncmp(name, section, name_len) == 0 && section[name_len] == '\0';
+}
+
+unsigned int kv_get_section_value(const char *str, const char *section, const char *key, char *value, unsigned int value_max)
+{
+    int in_section = kv_section_name_equal("", 0, section);
+    while (*str != '\0')
+    {
+        const char *name;
+        size_t name_len;
+        if (kv_section_header(str, &name, &name_len))
+        {
+            in_section = kv_section_name_equal(name, name_len, section);
+            str = kv_section_next_line(str);
+            continue;
+        }
+
+        if (!in_section)
+        {
+            str = kv_section_next_line(str);
+            continue;
+        }
+
+        /* Match the key the same way kv_section_table_get_value() and kv_get_value() do, one line at a time */
+        const char *next = kv_section_next_line(str);
+        kv_pair pair;
+        if (kv_scan_find(str, next, key, &pair))
+        {
+            return kv_scan_unescape(pair.value, pair.value_len, pair.flags, value, value_max);
+        }
+        str = next;
+    }
+
+    /* End of string. Key was not found. */
+    if (value_max > 0)
+    {
+        value[0] = '\0';
+    }
+    return 0;
+}
+
+size_t kv_section_count(const char *str)
+{
+    size_t count = 1;
+    for (; *str != '\0'; str = kv_section_next_line(str))
+    {
+        const char *name;
+        size_t name_len;
+        count += kv_section_header(str, &name, &name_len);
+    }
+    return count;
+}
+
+int kv_section_table_build(kv_section_table *table, const char *str, kv_section_entry *sections, size_t sections_max)
+{
+    table->str = str;
+    table->sections = sections;
+    table->count = 0;
+    if (sections_max == 0)
+    {
+        return -1;
+    }
+
+    /* Global section, up to the first header */
+    kv_section_entry *current = &sections[0];
+    current->name_offset = 0;
+    current->name_len = 0;
+    current->start = 0;
+    table->count = 1;
+
+    const char *line = str;
+    for (; *line != '\0'; line = kv_section_next_line(line))
+    {
+        const char *name;
+        size_t name_len;
+        if (!kv_section_header(line, &name, &name_len))
+        {
+            continue;
+        }
+
+        if (table->count >= sections_max)
+        {
+            return -1;
+        }
+
+        current->end = line - str;
+        current = &sections[table->count++];
+        current->name_offset = name - str;
+        current->name_len = name_len;
+        current->start = kv_section_next_line(line) - str;
+    }
+    current->end = line - str;
+    return 0;
+}
+
+unsigned int kv_section_table_get_value(const kv_section_table *table, const char *section, const char *key, char *value, unsigned int value_max)
+{
+    for (size_t s = 0; s < table->count; s++)
+    {
+        const kv_section_entry *entry = &table->sections[s];
+        if (!kv_section_name_equal(table->str + entry->name_offset, entry->name_len, section))
+        {
+            continue;
+        }
+
+        /* Only this section's byte range is scanned */
+        kv_pair pair;
+        if (kv_scan_find(table->str + entry->start, table->str + entry->end, key, &pair))
+        {
+            return kv_scan_unescape(pair.value, pair.value_len, pair.flags, value, value_max);
+        }
+    }
+
+    /* Key was not found. */
+    if (value_max > 0)
+    {
+        value[0] = '\0';
+    }
+    return 0;
+}
@@ -0,0 +1,108 @@
+/**
+ * @file kv_section.h
+ * @brief INI style `[section]` aware key-value lookups.
+ *
+ * This file contains functions that extract values associated with keys inside a named `[section]` of a
+ * formatted key-value string (e.g., "key=value" or "key: value"), and a table of section byte ranges so
+ * repeated lookups only scan the section they need.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_section_H
+#define kv_section_H
+#include <stddef.h>
+
+/**
+ * @brief Byte range of one section.
+ *
+ * Offsets are relative to the start of the indexed string.
+ */
+typedef struct
+{
+    size_t name_offset; /**< Offset of the section name (inside the brackets). */
+    size_t name_len;    /**< Length of the section name. `0` for the global section. */
+    size_t start;       /**< Offset of the first line after the `[section]` header. */
+    size_t end;         /**< Offset of the next section header, or of the end of the string. */
+} kv_section_entry;
+
+/**
+ * @brief Section table over a key-value string.
+ *
+ * The indexed string and the entry storage are owned by the caller and must outlive the table.
+ */
+typedef struct
+{
+    const char *str;            /**< Indexed string. */
+    kv_section_entry *sections; /**< Caller provided entries, in file order. Entry 0 is the global section. */
+    size_t count;               /**< Number of entries used. */
+} kv_section_table;
+
+/**
+ * @brief Parses a key-value pair from a named section of a given string.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * A line of the form `[name]` starts a section. Lines before the first header belong to the global section,
+ * selected with `section` set to `NULL` or `""`. Inside a section, lines follow the same rules as `kv_get_value()`.
+ * If a section appears more than once, its parts are searched in order and the first occurrence of the key wins.
+ *
+ * @param str Input string containing `[section]` headers and key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @param section The section to search, or `NULL` for the global section.
+ * @param key The key to search for in the section.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ *
+ * @example Usage Example:
+ * @code
+ * char buffer[50];
+ * unsigned int len = kv_get_section_value("[server]\nport=80\n[client]\nport=8080", "client", "port", buffer, sizeof(buffer));
+ * @endcode
+ */
+unsigned int kv_get_section_value(const char *str, const char *section, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Counts the entries a section table needs for a string.
+ *
+ * @param str Input string containing `[section]` headers and key-value pairs separated by newline.
+ * @return One entry for the global section plus one per `[section]` header.
+ */
+size_t kv_section_count(const char *str);
+
+/**
+ * @brief Records the byte range of every section in one pass.
+ *
+ * No memory is allocated; entries live in the caller provided `sections` storage.
+ *
+ * @param table Table to initialise.
+ * @param str Input string containing `[section]` headers and key-value pairs separated by newline.
+ * @param sections Entry storage. `kv_section_count()` entries are always enough.
+ * @param sections_max Number of entries in `sections`.
+ * @return `0` on success, or `-1` if `sections` is too small.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_section_entry sections[16];
+ * kv_section_table table;
+ * char buffer[50];
+ * if (kv_section_table_build(&table, ini, sections, 16) == 0) {
+ *     unsigned int len = kv_section_table_get_value(&table, "client", "port", buffer, sizeof(buffer));
+ * }
+ * @endcode
+ */
+int kv_section_table_build(kv_section_table *table, const char *str, kv_section_entry *sections, size_t sections_max);
+
+/**
+ * @brief Parses a key-value pair from a named section, scanning only that section's byte range.
+ *
+ * Same rules as `kv_get_section_value()`.
+ *
+ * @param table Table built with `kv_section_table_build()`.
+ * @param section The section to search, or `NULL` for the global section.
+ * @param key The key to search for in the section.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_section_table_get_value(const kv_section_table *table, const char *section, const char *key, char *value, unsigned int value_max);
+#endif
@@ -0,0 +1,391 @@
+/**
+ * @file kv_seek_index.c
+ * @brief Sparse, memory bounded seek index over a key-value file.
+ *
+ * This file contains functions that summarise a formatted key-value file (e.g., "key=value" or "key: value")
+ * as one entry per block of lines, holding the block's byte offset and a Bloom filter of its keys, so that
+ * lookups `fseek()` straight to the few blocks that may hold a key instead of reading the whole file.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+
+#include "kv_seek_index.h"
+#include "kv_index.h"
+#include <limits.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+/* Block offsets are seeked to with off_t, which _FILE_OFFSET_BITS widens to 64 bit on 32 bit targets */
+typedef off_t kv_seek_index_off;
+#define kv_seek_index_fseek fseeko
+#else
+/* Plain fseek() takes a long, only 32 bit on Windows. The build rejects files it cannot seek within. */
+typedef long kv_seek_index_off;
+#define kv_seek_index_fseek fseek
+#endif
+#define KV_SEEK_INDEX_OFF_MAX (((uint64_t)1 << (sizeof(kv_seek_index_off) * CHAR_BIT - 1)) - 1)
+
+/* Upper bound on the Bloom filter bits set per key */
+#define KV_SEEK_INDEX_HASHES_MAX 16
+
+/* Bit positions of a key hash in a filter of `bits` bits, by double hashing */
+static uint64_t kv_seek_index_bit(unsigned int hash, unsigned int k, uint64_t bits)
+{
+    const uint32_t step = (((uint32_t)hash >> 16) | ((uint32_t)hash << 16)) * 0x85EBCA6Bu | 1u;
+    return ((uint64_t)hash + (uint64_t)k * step) % bits;
+}
+
+static void kv_seek_index_bloom_add(const kv_seek_index *index, uint64_t *bloom, unsigned int hash)
+{
+    const uint64_t bits = 64u * (uint64_t)index->bloom_words;
+    for (unsigned int k = 0; k < index->hashes; k++)
+    {
+        const uint64_t bit = kv_seek_index_bit(hash, k, bits);
+        bloom[bit / 64] |= (uint64_t)1 << (bit % 64);
+    }
+}
+
+static int kv_seek_index_bloom_test(const kv_seek_index *index, const uint64_t *bloom, unsigned int hash)
+{
+    const uint64_t bits = 64u * (uint64_t)index->bloom_words;
+    for (unsigned int k = 0; k < index->hashes; k++)
+    {
+        const uint64_t bit = kv_seek_index_bit(hash, k, bits);
+        if (!(bloom[bit / 64] & ((uint64_t)1 << (bit % 64))))
+        {
+            return 0;
+        }
+    }
+    return 1;
+}
+
+/* Reads one character, counting the bytes read */
+static int kv_seek_index_getc(FILE *file, uint64_t *pos)
+{
+    const int ch = getc(file);
+    if (ch != EOF)
+    {
+        (*pos)++;
+    }
+    return ch;
+}
+
+/*
+ * Reads the rest of a line starting with `ch`. Returns 1 if it holds a key, with the hash of the key (the text before the first
+ * delimiter, whitespace trimmed). Returns the character that ended the line in `*end`.
+ */
+static int kv_seek_index_line(FILE *file, int ch, uint64_t *pos, unsigned int *hash, int *end)
+{
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (ch == ' ' || ch == '\t')
+    {
+        ch = kv_seek_index_getc(file, pos);
+    }
+#endif
+
+    /* Read Key Up To The First Delimiter */
+    char key[KV_SEEK_INDEX_KEY_MAX];
+    size_t key_len = 0;
+    size_t key_trim = 0;
+    while (ch != EOF && ch != '\n' && ch != '=' && ch != ':')
+    {
+        if (key_len < sizeof(key))
+        {
+            key[key_len] = ch;
+        }
+        key_len++;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        if (ch != ' ' && ch != '\t')
+        {
+            key_trim = key_len;
+        }
+#else
+        key_trim = key_len;
+#endif
+        ch = kv_seek_index_getc(file, pos);
+    }
+
+    const int found = (ch == '=' || ch == ':');
+    if (found)
+    {
+        *hash = kv_index_hash(key, key_trim < sizeof(key) ? key_trim : sizeof(key));
+    }
+
+    /* Search for start of next line */
+    while (ch != EOF && ch != '\n')
+    {
+        ch = kv_seek_index_getc(file, pos);
+    }
+    *end = ch;
+    return found;
+}
+
+/*
+ * Hashes a lookup key the way the build hashes line keys. A line holding `key` has its first delimiter where the key has
+ * its first one, so "a=b" is looked up as "a", and found in the blocks holding "a=b=1".
+ */
+static unsigned int kv_seek_index_key_hash(const char *key)
+{
+    size_t key_len = strcspn(key, "=:");
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    while (key_len > 0 && (key[key_len - 1] == ' ' || key[key_len - 1] == '\t'))
+    {
+        key_len--;
+    }
+#endif
+    return kv_index_hash(key, key_len < KV_SEEK_INDEX_KEY_MAX ? key_len : KV_SEEK_INDEX_KEY_MAX);
+}
+
+int kv_seek_index_build(kv_seek_index *index, FILE *file, uint64_t *storage, size_t memory_limit, unsigned long block_lines)
+{
+    const size_t words = memory_limit / sizeof(uint64_t);
+    index->file = file;
+    index->offsets = storage;
+    index->blooms = storage;
+    index->count = 0;
+    index->bloom_words = 0;
+    index->hashes = 1;
+    index->block_lines = block_lines;
+    if (words < 2 || block_lines == 0)
+    {
+        return -1;
+    }
+
+    /* Count Lines And Keys */
+    rewind(file);
+    uint64_t pos = 0;
+    unsigned long lines = 0;
+    unsigned long keys = 0;
+    for (int ch = kv_seek_index_getc(file, &pos); ch != EOF; ch = kv_seek_index_getc(file, &pos))
+    {
+        unsigned int hash;
+        lines++;
+        keys += kv_seek_index_line(file, ch, &pos, &hash, &ch);
+        if (ch == EOF)
+        {
+            break;
+        }
+    }
+    if (pos > KV_SEEK_INDEX_OFF_MAX)
+    {
+        /* Blocks past the largest seekable offset could not be read back */
+        return -1;
+    }
+
+    /*
+     * Lay Out The Blocks. A block costs one offset word plus its filter. Double the lines per block until the filters
+     * reach the bits per key aimed for, or the whole file is one block.
+     */
+    size_t count;
+    size_t bloom_words;
+    for (;;)
+    {
+        count = lines == 0 ? 0 : (size_t)((lines - 1) / block_lines + 1);
+        if (count <= words / 2)
+        {
+            bloom_words = count == 0 ? 1 : (words - count) / count;
+            if (count <= 1 || 64u * (uint64_t)bloom_words * count >= (uint64_t)KV_SEEK_INDEX_BITS_PER_KEY * keys)
+            {
+                break;
+            }
+        }
+        block_lines *= 2;
+    }
+
+    /* Bloom filter bits per key times ln(2) hashes gives the fewest false positives */
+    const uint64_t bits = 64u * (uint64_t)bloom_words * count;
+    uint64_t hashes = keys == 0 ? 1 : (bits * 693 / 1000 + keys / 2) / keys;
+    hashes = hashes < 1 ? 1 : hashes > KV_SEEK_INDEX_HASHES_MAX ? KV_SEEK_INDEX_HASHES_MAX : hashes;
+
+    index->blooms = storage + count;
+    index->count = count;
+    index->bloom_words = bloom_words;
+    index->hashes = (unsigned int)hashes;
+    index->block_lines = block_lines;
+    memset(index->blooms, 0, count * bloom_words * sizeof(uint64_t));
+
+    /* Fill The Blocks */
+    rewind(file);
+    pos = 0;
+    unsigned long line = 0;
+    for (int ch = kv_seek_index_getc(file, &pos); ch != EOF; ch = kv_seek_index_getc(file, &pos), line++)
+    {
+        /* Block i covers lines [i * block_lines, (i + 1) * block_lines) */
+        const size_t b = (size_t)(line / block_lines);
+        if (b >= count)
+        {
+            /* File grew since it was counted */
+            break;
+        }
+        if (line % block_lines == 0)
+        {
+            index->offsets[b] = pos - 1;
+        }
+
+        unsigned int hash;
+        if (kv_seek_index_line(file, ch, &pos, &hash, &ch))
+        {
+            kv_seek_index_bloom_add(index, index->blooms + b * bloom_words, hash);
+        }
+        if (ch == EOF)
+        {
+            break;
+        }
+    }
+
+    return 0;
+}
+
+/* Looks for the key in the `lines` lines starting at the file position. Returns 1 if found, with the value copied. */
+static int kv_seek_index_scan(FILE *file, unsigned long lines, const char *key, char *value, unsigned int value_max, unsigned int *value_len)
+{
+    for (int ch = getc(file); ch != EOF && lines > 0; ch = getc(file))
+    {
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Check For Key */
+        for (int i = 0; key[i] != '\0'; i++, ch = getc(file))
+        {
+            if (ch != key[i])
+            {
+                goto skip_line;
+            }
+        }
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Check For Key Value Delimiter */
+        if (ch != '=' && ch != ':')
+        {
+            goto skip_line;
+        }
+        ch = getc(file);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            ch = getc(file);
+        }
+#endif
+
+        /* Copy Value To Buffer */
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        int quote = EOF;
+        int prev = EOF;
+#endif
+        for (unsigned int i = 0; i + 1 < value_max; ch = getc(file))
+        {
+            if (ch == EOF || ch == '\r' || ch == '\n')
+            {
+                /* End Of Line. Trim trailing whitespace. */
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                while (i > 0 && (value[i - 1] == ' ' || value[i - 1] == '\t'))
+                {
+                    i--;
+                }
+#endif
+                value[i] = '\0';
+                *value_len = i;
+                return 1;
+            }
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+            else if (quote == EOF && (ch == '\'' || ch == '"'))
+            {
+                /* Start Of Quoted String */
+                quote = ch;
+                continue;
+            }
+            else if (quote != EOF && prev != '\\' && ch == quote)
+            {
+                /* End Of Quoted String */
+                value[i] = '\0';
+                *value_len = i;
+                return 1;
+            }
+            else if (quote != EOF && prev == '\\' && ch == quote)
+            {
+                /* Escaped Quote Character In Quoted String */
+                value[i - 1] = ch;
+                continue;
+            }
+
+            prev = ch;
+#endif
+
+            value[i++] = ch;
+        }
+
+        /* Value too large for buffer. Don't return a value. */
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        *value_len = 0;
+        return 1;
+
+    skip_line:
+        /* Search for start of next line */
+        while (ch != '\n')
+        {
+            if (ch == EOF)
+            {
+                return 0;
+            }
+            ch = getc(file);
+        }
+        lines--;
+    }
+
+    return 0;
+}
+
+size_t kv_seek_index_candidates(const kv_seek_index *index, const char *key)
+{
+    const unsigned int hash = kv_seek_index_key_hash(key);
+    size_t candidates = 0;
+    for (size_t b = 0; b < index->count; b++)
+    {
+        candidates += kv_seek_index_bloom_test(index, index->blooms + b * index->bloom_words, hash);
+    }
+    return candidates;
+}
+
+unsigned int kv_seek_index_get_value(const kv_seek_index *index, const char *key, char *value, unsigned int value_max)
+{
+    const unsigned int hash = kv_seek_index_key_hash(key);
+    for (size_t b = 0; b < index->count; b++)
+    {
+        if (!kv_seek_index_bloom_test(index, index->blooms + b * index->bloom_words, hash))
+        {
+            continue;
+        }
+
+        /* Candidate block. Could still be a false positive. */
+        unsigned int value_len;
+        if (kv_seek_index_fseek(index->file, (kv_seek_index_off)index->offsets[b], SEEK_SET) == 0 && kv_seek_index_scan(index->file, index->block_lines, key, value, value_max, &value_len))
+        {
+            return value_len;
+        }
+    }
+
+    /* Key was not found. */
+    if (value_max > 0)
+    {
+        value[0] = '\0';
+    }
+    return 0;
+}
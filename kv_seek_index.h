@@ -0,0 +1,98 @@
+/**
+ * @file kv_seek_index.h
+ * @brief Sparse, memory bounded seek index over a key-value file.
+ *
+ * This file contains functions that summarise a formatted key-value file (e.g., "key=value" or "key: value")
+ * as one entry per block of lines, holding the block's byte offset and a Bloom filter of its keys, so that
+ * lookups `fseek()` straight to the few blocks that may hold a key instead of reading the whole file.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_seek_index_H
+#define kv_seek_index_H
+#include <stddef.h>
+#include <stdint.h>
+#include <stdio.h>
+
+/** Bloom filter bits per key aimed for. 10 bits per key gives about 1% of blocks read in vain per lookup. */
+#ifndef KV_SEEK_INDEX_BITS_PER_KEY
+#define KV_SEEK_INDEX_BITS_PER_KEY 10
+#endif
+
+/** Characters of a key that are hashed. Longer keys share the hash of their first characters. */
+#ifndef KV_SEEK_INDEX_KEY_MAX
+#define KV_SEEK_INDEX_KEY_MAX 256
+#endif
+
+/**
+ * @brief Sparse seek index over a key-value file.
+ *
+ * The file and the storage are owned by the caller and must outlive the index.
+ */
+typedef struct
+{
+    FILE *file;                /**< Indexed file. */
+    uint64_t *offsets;         /**< Byte offset of each block's first line. */
+    uint64_t *blooms;          /**< Bloom filter of each block's keys, `bloom_words` words per block. */
+    size_t count;              /**< Number of blocks. */
+    size_t bloom_words;        /**< 64 bit words of Bloom filter per block. */
+    unsigned int hashes;       /**< Bloom filter bits set per key. */
+    unsigned long block_lines; /**< Lines per block. */
+} kv_seek_index;
+
+/**
+ * @brief Reads a key-value file and builds a sparse index of it within a fixed amount of memory.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * The file is read twice: once to count its lines and keys, and once to fill the index. The file is split into blocks
+ * of `block_lines` lines, doubled until the blocks' offsets and Bloom filters fit in `memory_limit` bytes with
+ * `KV_SEEK_INDEX_BITS_PER_KEY` bits per key, so the share of blocks read in vain stays the same however large the file.
+ * If even one block cannot reach that, the whole file becomes one block and a lookup reads no more than a plain scan.
+ * No memory is allocated; everything lives in the caller provided `storage`.
+ *
+ * @param index Index to initialise.
+ * @param file Seekable input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @param storage Index storage of at least `memory_limit` bytes.
+ * @param memory_limit Size of `storage` in bytes. Must hold at least two words.
+ * @param block_lines Smallest number of lines per block. Must not be `0`.
+ * @return `0` on success, or `-1` if `memory_limit` is too small, `block_lines` is `0`, or the file is larger than the
+ *         platform can seek within (`LONG_MAX` bytes where `fseeko()` is unavailable).
+ *
+ * @example Usage Example:
+ * @code
+ * static uint64_t storage[16384];
+ * kv_seek_index index;
+ * char buffer[50];
+ * if (kv_seek_index_build(&index, file, storage, sizeof(storage), 64) == 0) {
+ *     unsigned int len = kv_seek_index_get_value(&index, "mode", buffer, sizeof(buffer));
+ * }
+ * @endcode
+ */
+int kv_seek_index_build(kv_seek_index *index, FILE *file, uint64_t *storage, size_t memory_limit, unsigned long block_lines);
+
+/**
+ * @brief Counts the blocks a lookup of `key` would read.
+ *
+ * Every block holding the key is counted, plus the blocks whose Bloom filter matches it by chance.
+ *
+ * @param index Index built with `kv_seek_index_build()`.
+ * @param key The key to search for.
+ * @return The number of candidate blocks.
+ */
+size_t kv_seek_index_candidates(const kv_seek_index *index, const char *key);
+
+/**
+ * @brief Gets the value for a key, reading only the blocks whose Bloom filter may hold it.
+ *
+ * Lines follow the same rules as `kv_file_get_value()`, and the first occurrence of a key wins.
+ * The file must not change after the index was built.
+ *
+ * @param index Index built with `kv_seek_index_build()`.
+ * @param key The key to search for.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_seek_index_get_value(const kv_seek_index *index, const char *key, char *value, unsigned int value_max);
+#endif
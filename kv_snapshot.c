@@ -0,0 +1,198 @@
+/**
+ * @file kv_snapshot.c
+ * @brief Thread safe key-value store with lock free readers.
+ *
+ * This file contains a store that publishes immutable indexed snapshots of a formatted key-value file
+ * (e.g., "key=value" or "key: value"). Readers never take a lock; a reloader swaps in new snapshots with an
+ * atomic pointer exchange and old snapshots are freed once no reader can still see them (epoch based reclamation).
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_snapshot.h"
+#include "kv_mapped_file.h"
+#include <stdlib.h>
+#include <string.h>
+
+/*
+ * Reclamation protocol:
+ * - A reader stores the global epoch into its slot, then loads `current`.
+ * - A publisher exchanges `current`, then advances the global epoch to E and retires the old snapshot at E.
+ * - A reader whose slot holds an epoch >= E loaded `current` after the exchange, so it cannot hold the old
+ *   snapshot. Once every active slot is >= E (or idle), the old snapshot is freed.
+ * All atomics are sequentially consistent, which gives the store -> load ordering this relies on.
+ */
+
+static void kv_snapshot_free(kv_snapshot *snapshot)
+{
+    free(snapshot->data);
+    free(snapshot->slots);
+    free(snapshot);
+}
+
+int kv_snapshot_store_init(kv_snapshot_store *store)
+{
+    memset(store, 0, sizeof(*store));
+    store->epoch = 1;
+    return pthread_mutex_init(&store->writer_lock, NULL) == 0 ? 0 : -1;
+}
+
+void kv_snapshot_store_free(kv_snapshot_store *store)
+{
+    while (store->retired != NULL)
+    {
+        kv_snapshot *next = store->retired->next;
+        kv_snapshot_free(store->retired);
+        store->retired = next;
+    }
+
+    if (store->current != NULL)
+    {
+        kv_snapshot_free(store->current);
+        store->current = NULL;
+    }
+
+    pthread_mutex_destroy(&store->writer_lock);
+}
+
+/* Lowest epoch of any active reader, or ~0 if none are reading */
+static unsigned long kv_snapshot_min_reader_epoch(kv_snapshot_store *store)
+{
+    unsigned long min_epoch = ~0UL;
+    for (int i = 0; i < KV_SNAPSHOT_MAX_READERS; i++)
+    {
+        const unsigned long epoch = __atomic_load_n(&store->readers[i].epoch, __ATOMIC_SEQ_CST);
+        if (epoch != 0 && epoch < min_epoch)
+        {
+            min_epoch = epoch;
+        }
+    }
+    return min_epoch;
+}
+
+/* Caller holds writer_lock */
+static void kv_snapshot_reclaim_locked(kv_snapshot_store *store)
+{
+    const unsigned long min_epoch = kv_snapshot_min_reader_epoch(store);
+    kv_snapshot **link = &store->retired;
+    while (*link != NULL)
+    {
+        kv_snapshot *snapshot = *link;
+        if (snapshot->retire_epoch <= min_epoch)
+        {
+            *link = snapshot->next;
+            kv_snapshot_free(snapshot);
+        }
+        else
+        {
+            link = &snapshot->next;
+        }
+    }
+}
+
+void kv_snapshot_store_reclaim(kv_snapshot_store *store)
+{
+    pthread_mutex_lock(&store->writer_lock);
+    kv_snapshot_reclaim_locked(store);
+    pthread_mutex_unlock(&store->writer_lock);
+}
+
+int kv_snapshot_store_publish(kv_snapshot_store *store, const char *str, size_t len)
+{
+    /* Parse outside the lock. Nothing is shared until the exchange. */
+    kv_snapshot *snapshot = malloc(sizeof(*snapshot));
+    char *data = malloc(len + 1);
+    if (snapshot == NULL || data == NULL)
+    {
+        free(snapshot);
+        free(data);
+        return -1;
+    }
+    memcpy(data, str, len);
+    data[len] = '\0';
+
+    const size_t slot_count = kv_index_slot_count(data);
+    kv_index_entry *slots = malloc(slot_count * sizeof(*slots));
+    if (slots == NULL || kv_index_build(&snapshot->index, data, slots, slot_count) != 0)
+    {
+        free(slots);
+        free(data);
+        free(snapshot);
+        return -1;
+    }
+    snapshot->data = data;
+    snapshot->slots = slots;
+    snapshot->next = NULL;
+
+    pthread_mutex_lock(&store->writer_lock);
+    kv_snapshot *old = __atomic_exchange_n(&store->current, snapshot, __ATOMIC_SEQ_CST);
+    if (old != NULL)
+    {
+        old->retire_epoch = __atomic_add_fetch(&store->epoch, 1, __ATOMIC_SEQ_CST);
+        old->next = store->retired;
+        store->retired = old;
+    }
+    kv_snapshot_reclaim_locked(store);
+    pthread_mutex_unlock(&store->writer_lock);
+    return 0;
+}
+
+int kv_snapshot_store_publish_path(kv_snapshot_store *store, const char *path)
+{
+    kv_mapped_file mapped;
+    if (kv_mapped_file_open(&mapped, path) != 0)
+    {
+        return -1;
+    }
+
+    const int result = kv_snapshot_store_publish(store, mapped.data ? mapped.data : "", mapped.size);
+    kv_mapped_file_close(&mapped);
+    return result;
+}
+
+int kv_snapshot_store_register(kv_snapshot_store *store)
+{
+    for (int i = 0; i < KV_SNAPSHOT_MAX_READERS; i++)
+    {
+        unsigned long expected = 0;
+        if (__atomic_compare_exchange_n(&store->readers[i].in_use, &expected, 1, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST))
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+void kv_snapshot_store_unregister(kv_snapshot_store *store, int reader)
+{
+    __atomic_store_n(&store->readers[reader].epoch, 0, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&store->readers[reader].in_use, 0, __ATOMIC_SEQ_CST);
+}
+
+const kv_index *kv_snapshot_read_begin(kv_snapshot_store *store, int reader)
+{
+    __atomic_store_n(&store->readers[reader].epoch, __atomic_load_n(&store->epoch, __ATOMIC_SEQ_CST), __ATOMIC_SEQ_CST);
+    const kv_snapshot *snapshot = __atomic_load_n(&store->current, __ATOMIC_SEQ_CST);
+    return snapshot ? &snapshot->index : NULL;
+}
+
+void kv_snapshot_read_end(kv_snapshot_store *store, int reader)
+{
+    __atomic_store_n(&store->readers[reader].epoch, 0, __ATOMIC_RELEASE);
+}
+
+unsigned int kv_snapshot_store_get_value(kv_snapshot_store *store, int reader, const char *key, char *value, unsigned int value_max)
+{
+    const kv_index *index = kv_snapshot_read_begin(store, reader);
+    unsigned int len = 0;
+    if (index != NULL)
+    {
+        len = kv_index_get_value(index, key, value, value_max);
+    }
+    else if (value_max > 0)
+    {
+        value[0] = '\0';
+    }
+    kv_snapshot_read_end(store, reader);
+    return len;
+}
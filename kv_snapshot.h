@@ -0,0 +1,154 @@
+/**
+ * @file kv_snapshot.h
+ * @brief Thread safe key-value store with lock free readers.
+ *
+ * This file contains a store that publishes immutable indexed snapshots of a formatted key-value file
+ * (e.g., "key=value" or "key: value"). Readers never take a lock; a reloader swaps in new snapshots with an
+ * atomic pointer exchange and old snapshots are freed once no reader can still see them (epoch based reclamation).
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_snapshot_H
+#define kv_snapshot_H
+#include "kv_index.h"
+#include <pthread.h>
+
+/** Maximum number of concurrently registered reader threads */
+#ifndef KV_SNAPSHOT_MAX_READERS
+#define KV_SNAPSHOT_MAX_READERS 64
+#endif
+
+/**
+ * @brief Immutable parsed snapshot.
+ */
+typedef struct kv_snapshot
+{
+    char *data;                 /**< NUL terminated copy of the key-value text. */
+    kv_index_entry *slots;      /**< Index slot table. */
+    kv_index index;             /**< Index over `data`. */
+    unsigned long retire_epoch; /**< Epoch at which the snapshot was replaced. */
+    struct kv_snapshot *next;   /**< Next snapshot waiting to be freed. */
+} kv_snapshot;
+
+/**
+ * @brief Per reader state, one cache line each so readers do not contend.
+ */
+typedef struct
+{
+    unsigned long epoch;  /**< Epoch the reader entered at, or `0` when not reading. */
+    unsigned long in_use; /**< Slot is registered to a thread. */
+    char pad[64 - 2 * sizeof(unsigned long)];
+} kv_snapshot_reader;
+
+/**
+ * @brief Store of the current snapshot.
+ */
+typedef struct
+{
+    kv_snapshot *current;                                /**< Current snapshot, swapped atomically. */
+    unsigned long epoch;                                 /**< Global epoch, advanced on every publish. */
+    kv_snapshot_reader readers[KV_SNAPSHOT_MAX_READERS]; /**< Reader slots. */
+    pthread_mutex_t writer_lock;                         /**< Serialises publishers. Never taken by readers. */
+    kv_snapshot *retired;                                /**< Replaced snapshots not yet freed. */
+} kv_snapshot_store;
+
+/**
+ * @brief Initialises an empty store.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * @param store Store to initialise.
+ * @return `0` on success, or `-1` on failure.
+ *
+ * @example Usage Example:
+ * @code
+ * // Reloader thread
+ * kv_snapshot_store_publish_path(&store, "/etc/myapp.conf");
+ *
+ * // Worker thread
+ * int reader = kv_snapshot_store_register(&store);
+ * unsigned int len = kv_snapshot_store_get_value(&store, reader, "mode", buffer, sizeof(buffer));
+ * @endcode
+ */
+int kv_snapshot_store_init(kv_snapshot_store *store);
+
+/**
+ * @brief Frees the store and every snapshot. No reader may be active.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ */
+void kv_snapshot_store_free(kv_snapshot_store *store);
+
+/**
+ * @brief Parses a copy of `str` into a new snapshot and makes it current.
+ *
+ * Readers that already hold the previous snapshot keep using it until they call `kv_snapshot_read_end()`.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ * @param str Key-value text to publish. Need not be NUL terminated.
+ * @param len Length of `str`.
+ * @return `0` on success, or `-1` if memory could not be allocated.
+ */
+int kv_snapshot_store_publish(kv_snapshot_store *store, const char *str, size_t len);
+
+/**
+ * @brief Reads a key-value file into a new snapshot and makes it current.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ * @param path Path of the key-value file.
+ * @return `0` on success, or `-1` if the file cannot be read. The current snapshot is kept on failure.
+ */
+int kv_snapshot_store_publish_path(kv_snapshot_store *store, const char *path);
+
+/**
+ * @brief Frees replaced snapshots that no reader can still see. Also done on every publish.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ */
+void kv_snapshot_store_reclaim(kv_snapshot_store *store);
+
+/**
+ * @brief Claims a reader slot for the calling thread.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ * @return Reader id, or `-1` if all `KV_SNAPSHOT_MAX_READERS` slots are taken.
+ */
+int kv_snapshot_store_register(kv_snapshot_store *store);
+
+/**
+ * @brief Releases a reader slot claimed with `kv_snapshot_store_register()`.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ * @param reader Reader id.
+ */
+void kv_snapshot_store_unregister(kv_snapshot_store *store, int reader);
+
+/**
+ * @brief Enters a read side critical section and returns the current snapshot. Never blocks.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ * @param reader Reader id of the calling thread.
+ * @return The current snapshot's index, or `NULL` if nothing has been published. Valid until `kv_snapshot_read_end()`.
+ */
+const kv_index *kv_snapshot_read_begin(kv_snapshot_store *store, int reader);
+
+/**
+ * @brief Leaves a read side critical section.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ * @param reader Reader id of the calling thread.
+ */
+void kv_snapshot_read_end(kv_snapshot_store *store, int reader);
+
+/**
+ * @brief Gets a value from the current snapshot. Never blocks.
+ *
+ * @param store Store initialised with `kv_snapshot_store_init()`.
+ * @param reader Reader id of the calling thread.
+ * @param key The key to search for.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_snapshot_store_get_value(kv_snapshot_store *store, int reader, const char *key, char *value, unsigned int value_max);
+#endif
@@ -0,0 +1,221 @@
+/**
+ * @file kv_sorted.c
+ * @brief Binary search lookups over key-value input sorted by key.
+ *
+ * This file contains functions that find a key in a formatted key-value buffer or file (e.g., "key=value" or "key: value")
+ * whose lines are sorted by key, by jumping to byte offsets and resyncing to the next line start instead of scanning every line.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+#define _FILE_OFFSET_BITS 64
+
+#include "kv_sorted.h"
+#include "kv_scan.h"
+#include <limits.h>
+#include <stdint.h>
+#include <string.h>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <sys/types.h>
+/* 64 bit file offsets, also on 32 bit targets thanks to _FILE_OFFSET_BITS */
+typedef off_t kv_sorted_off;
+#define kv_sorted_fseek fseeko
+#define kv_sorted_ftell ftello
+#else
+/* Only fseek() is portable, and its long offset is 32 bit on Windows. Files past LONG_MAX are rejected. */
+typedef long kv_sorted_off;
+#define kv_sorted_fseek fseek
+#define kv_sorted_ftell ftell
+#endif
+#define KV_SORTED_OFF_MAX (((uintmax_t)1 << (sizeof(kv_sorted_off) * CHAR_BIT - 1)) - 1)
+
+/* Input being searched. Either a buffer in memory, or a file read one window at a time. */
+typedef struct
+{
+    const char *data;
+    FILE *file;
+    char *window;
+    size_t len;
+} kv_sorted_source;
+
+/* Returns the bytes from `offset` up to `*end`. `*end` is the end of the input, or of the file window. */
+static const char *kv_sorted_fetch(kv_sorted_source *src, size_t offset, const char **end)
+{
+    if (src->file == NULL)
+    {
+        *end = src->data + src->len;
+        return src->data + offset;
+    }
+
+    size_t n = 0;
+    if (kv_sorted_fseek(src->file, (kv_sorted_off)offset, SEEK_SET) == 0)
+    {
+        n = fread(src->window, 1, KV_SORTED_FILE_WINDOW, src->file);
+    }
+    *end = src->window + n;
+    return src->window;
+}
+
+/* Returns the first line start at or after `offset`, or the end of the input. */
+static size_t kv_sorted_resync(kv_sorted_source *src, size_t offset)
+{
+    if (offset == 0)
+    {
+        return 0;
+    }
+
+    /* The line starts here if the previous byte ends a line */
+    offset--;
+    while (offset < src->len)
+    {
+        const char *end;
+        const char *str = kv_sorted_fetch(src, offset, &end);
+        const char *eol = memchr(str, '\n', end - str);
+        if (eol != NULL)
+        {
+            return offset + (eol - str) + 1;
+        }
+        if (end == str)
+        {
+            break;
+        }
+        offset += end - str;
+    }
+    return src->len;
+}
+
+/*
+ * Scans the line at `offset`. Returns 1 with the pair if the whole line was read, or 0 if it is longer than the file window.
+ * `*scanned` is the next line start, or for a partly read line where to resync from. Resyncing reuses the file window,
+ * so the pair must be used first.
+ */
+static int kv_sorted_line(kv_sorted_source *src, size_t offset, kv_pair *pair, size_t *scanned)
+{
+    const char *end;
+    const char *str = kv_sorted_fetch(src, offset, &end);
+    const char *line_end = kv_scan_pair(str, end, pair);
+    *scanned = offset + (line_end - str);
+    return line_end < end || *scanned >= src->len;
+}
+
+/* Compares a line's key slice with the requested key in byte order */
+static int kv_sorted_compare(const kv_pair *pair, const char *key, size_t key_len)
+{
+    const size_t n = pair->key_len < key_len ? pair->key_len : key_len;
+    const int cmp = memcmp(pair->key, key, n);
+    if (cmp != 0)
+    {
+        return cmp;
+    }
+    return pair->key_len < key_len ? -1 : pair->key_len > key_len;
+}
+
+static unsigned int kv_sorted_search(kv_sorted_source *src, const char *key, char *value, unsigned int value_max)
+{
+    if (value_max > 0)
+    {
+        value[0] = '\0';
+    }
+
+    const size_t key_len = strlen(key);
+
+    /*
+     * Lower bound over line starts. Every pair starting before `lo` has a smaller key,
+     * and every pair starting at or after `hi` has a key no smaller than the one requested.
+     */
+    size_t lo = 0;
+    size_t hi = src->len;
+    while (lo < hi)
+    {
+        size_t line = kv_sorted_resync(src, lo + (hi - lo) / 2);
+        if (line >= hi)
+        {
+            /* No line starts in the upper half. Probe the first line instead. */
+            line = lo;
+        }
+
+        /* Skip lines without a pair */
+        const size_t probe = line;
+        kv_pair pair;
+        size_t scanned = line;
+        int complete = 1;
+        while (line < hi)
+        {
+            complete = kv_sorted_line(src, line, &pair, &scanned);
+            if (pair.key != NULL)
+            {
+                break;
+            }
+            line = complete ? scanned : kv_sorted_resync(src, scanned);
+        }
+
+        if (line >= hi)
+        {
+            /* Nothing but blank lines from the probe up to `hi` */
+            hi = probe;
+        }
+        else if (kv_sorted_compare(&pair, key, key_len) < 0)
+        {
+            lo = complete ? scanned : kv_sorted_resync(src, scanned);
+        }
+        else
+        {
+            hi = line;
+        }
+    }
+
+    /* The first pair at or after `lo` is the only candidate */
+    for (size_t line = lo; line < src->len;)
+    {
+        kv_pair pair;
+        size_t scanned;
+        const int complete = kv_sorted_line(src, line, &pair, &scanned);
+        if (pair.key == NULL)
+        {
+            line = complete ? scanned : kv_sorted_resync(src, scanned);
+            continue;
+        }
+
+        if (kv_sorted_compare(&pair, key, key_len) != 0 || !complete)
+        {
+            /* Key not found, or its line is longer than the file window */
+            return 0;
+        }
+        return kv_scan_unescape(pair.value, pair.value_len, pair.flags, value, value_max);
+    }
+
+    /* End of input. Key was not found. */
+    return 0;
+}
+
+unsigned int kv_sorted_get_value(const char *str, size_t len, const char *key, char *value, unsigned int value_max)
+{
+    kv_sorted_source src = {str, NULL, NULL, len};
+    return kv_sorted_search(&src, key, value, value_max);
+}
+
+unsigned int kv_file_sorted_get_value(FILE *file, const char *key, char *value, unsigned int value_max)
+{
+    char window[KV_SORTED_FILE_WINDOW];
+    kv_sorted_source src = {NULL, file, window, 0};
+
+    kv_sorted_off size = -1;
+    if (kv_sorted_fseek(file, 0, SEEK_END) == 0)
+    {
+        size = kv_sorted_ftell(file);
+    }
+    if (size < 0 || (uintmax_t)size > KV_SORTED_OFF_MAX || (uintmax_t)size > SIZE_MAX)
+    {
+        /* Not seekable, or too large to address */
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    src.len = (size_t)size;
+    return kv_sorted_search(&src, key, value, value_max);
+}
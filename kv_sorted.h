@@ -0,0 +1,63 @@
+/**
+ * @file kv_sorted.h
+ * @brief Binary search lookups over key-value input sorted by key.
+ *
+ * This file contains functions that find a key in a formatted key-value buffer or file (e.g., "key=value" or "key: value")
+ * whose lines are sorted by key, by jumping to byte offsets and resyncing to the next line start instead of scanning every line.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_sorted_H
+#define kv_sorted_H
+#include <stddef.h>
+#include <stdio.h>
+
+/** Bytes read at each probe of `kv_file_sorted_get_value()`. A matching line longer than this returns no value. */
+#ifndef KV_SORTED_FILE_WINDOW
+#define KV_SORTED_FILE_WINDOW 4096
+#endif
+
+/**
+ * @brief Parses a key-value pair from a length delimited buffer sorted by key, with a binary search.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Lines must be sorted by key in byte order (e.g. `LC_ALL=C sort -t= -k1,1`). Note that sorting whole lines is not quite the same,
+ * as `'='` sorts after `'.'`. Lines without a key-value pair may appear anywhere. If a key appears more than once, the first
+ * occurrence wins. Otherwise the same rules as `kv_get_value()` apply. Unsorted input gives unspecified results.
+ *
+ * Each lookup reads O(log n) lines. The length is taken rather than found, as finding the end of a NUL terminated string
+ * would read every line. The buffer need not be NUL terminated, so it suits a mapped file (see `kv_mapped_file_open()`).
+ *
+ * @param str Input buffer containing key-value pairs (e.g., `"key=value"`) sorted by key and separated by newline.
+ * @param len Length of `str`.
+ * @param key The key to search for in the input buffer.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ *
+ * @example Usage Example:
+ * @code
+ * static const char table[] = "alpha=1\nbeta=2\ngamma=3";
+ * char buffer[50];
+ * unsigned int len = kv_sorted_get_value(table, sizeof(table) - 1, "beta", buffer, sizeof(buffer));
+ * @endcode
+ */
+unsigned int kv_sorted_get_value(const char *str, size_t len, const char *key, char *value, unsigned int value_max);
+
+/**
+ * @brief Parses a key-value pair from a seekable file sorted by key, with a binary search.
+ *
+ * Same rules as `kv_sorted_get_value()`. Each probe seeks to a byte offset and reads `KV_SORTED_FILE_WINDOW` bytes,
+ * so no index is kept in memory. Lines longer than the window can be searched past, but their value is not returned.
+ * Offsets are 64 bit where `fseeko()` is available. Elsewhere files larger than `LONG_MAX` bytes are rejected.
+ *
+ * @param file Seekable input file stream containing key-value pairs (e.g., "key=value") sorted by key and separated by newline.
+ * @param key The key to search for in the input file.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found, does not fit,
+ *         or the file is not seekable or too large to address.
+ */
+unsigned int kv_file_sorted_get_value(FILE *file, const char *key, char *value, unsigned int value_max);
+#endif
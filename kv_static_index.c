@@ -0,0 +1,153 @@
+/**
+ * @file kv_static_index.c
+ * @brief Fixed capacity index over a small key-value string, for targets without a heap.
+ *
+ * This file contains functions that parse a formatted key-value string (e.g., "key=value" or "key: value")
+ * once into a compile time sized table kept in caller provided (typically static) storage, so that later
+ * lookups take a bounded binary search instead of rescanning the string. It never allocates memory.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_static_index.h"
+#include "kv_scan.h"
+#include <string.h>
+
+/* FNV-1a, folded down to 16 bits */
+static uint16_t kv_static_index_hash(const char *key, size_t key_len)
+{
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < key_len; i++)
+    {
+        hash ^= (unsigned char)key[i];
+        hash *= 16777619u;
+    }
+    return (uint16_t)((hash >> 16) ^ hash);
+}
+
+/* Returns the first slot whose hash is not below `hash` */
+static unsigned int kv_static_index_lower_bound(const kv_static_index *index, uint16_t hash)
+{
+    unsigned int lo = 0;
+    unsigned int hi = index->count;
+    while (lo < hi)
+    {
+        const unsigned int mid = lo + (hi - lo) / 2;
+        if (index->hashes[mid] < hash)
+        {
+            lo = mid + 1;
+        }
+        else
+        {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+/* Returns the slot holding the key, or `index->count` if it is not indexed */
+static unsigned int kv_static_index_find(const kv_static_index *index, const char *key, size_t key_len, uint16_t hash)
+{
+    unsigned int slot = kv_static_index_lower_bound(index, hash);
+    for (; slot < index->count && index->hashes[slot] == hash; slot++)
+    {
+        if (index->key_lens[slot] == key_len && memcmp(index->str + index->key_offsets[slot], key, key_len) == 0)
+        {
+            return slot;
+        }
+    }
+    return index->count;
+}
+
+int kv_static_index_build(kv_static_index *index, const char *str)
+{
+    index->str = str;
+    index->count = 0;
+
+    const size_t len = strlen(str);
+    if (len > KV_STATIC_INDEX_STR_MAX)
+    {
+        return -1;
+    }
+
+    const char *line = str;
+    while (*line != '\0')
+    {
+        kv_pair pair;
+        line = kv_scan_pair(line, NULL, &pair);
+        if (pair.key == NULL)
+        {
+            continue;
+        }
+        if (pair.key_len > KV_STATIC_INDEX_KEY_MAX)
+        {
+            return -1;
+        }
+
+        const uint16_t hash = kv_static_index_hash(pair.key, pair.key_len);
+        if (kv_static_index_find(index, pair.key, pair.key_len, hash) != index->count)
+        {
+            /* Duplicate Key. First occurrence wins. */
+            continue;
+        }
+        if (index->count >= KV_STATIC_INDEX_CAPACITY)
+        {
+            return -1;
+        }
+
+        /* Insert after any equal hashes, keeping the arrays sorted */
+        unsigned int slot = kv_static_index_lower_bound(index, hash);
+        while (slot < index->count && index->hashes[slot] == hash)
+        {
+            slot++;
+        }
+        for (unsigned int i = index->count; i > slot; i--)
+        {
+            index->hashes[i] = index->hashes[i - 1];
+            index->key_offsets[i] = index->key_offsets[i - 1];
+            index->value_offsets[i] = index->value_offsets[i - 1];
+            index->value_lens[i] = index->value_lens[i - 1];
+            index->key_lens[i] = index->key_lens[i - 1];
+            index->flags[i] = index->flags[i - 1];
+        }
+        index->hashes[slot] = hash;
+        index->key_offsets[slot] = (uint16_t)(pair.key - str);
+        index->value_offsets[slot] = (uint16_t)(pair.value - str);
+        index->value_lens[slot] = (uint16_t)pair.value_len;
+        index->key_lens[slot] = (uint8_t)pair.key_len;
+        index->flags[slot] = (uint8_t)pair.flags;
+        index->count++;
+    }
+
+    return 0;
+}
+
+unsigned int kv_static_index_get_value(const kv_static_index *index, const char *key, char *value, unsigned int value_max)
+{
+    const size_t key_len = strlen(key);
+    int indexed = key_len <= KV_STATIC_INDEX_KEY_MAX && strpbrk(key, "=:") == NULL;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    indexed = indexed && !(key_len > 0 && (key[key_len - 1] == ' ' || key[key_len - 1] == '\t'));
+#endif
+    if (!indexed)
+    {
+        /* Indexed keys end at the first delimiter, trimmed. Others can only match by prefix, as in kv_get_value(). */
+        kv_pair pair;
+        if (kv_scan_find(index->str, NULL, key, &pair))
+        {
+            return kv_scan_unescape(pair.value, pair.value_len, pair.flags, value, value_max);
+        }
+    }
+
+    const unsigned int slot = indexed ? kv_static_index_find(index, key, key_len, kv_static_index_hash(key, key_len)) : index->count;
+    if (slot == index->count)
+    {
+        if (value_max > 0)
+        {
+            value[0] = '\0';
+        }
+        return 0;
+    }
+
+    return kv_scan_unescape(index->str + index->value_offsets[slot], index->value_lens[slot], index->flags[slot], value, value_max);
+}
@@ -0,0 +1,82 @@
+/**
+ * @file kv_static_index.h
+ * @brief Fixed capacity index over a small key-value string, for targets without a heap.
+ *
+ * This file contains functions that parse a formatted key-value string (e.g., "key=value" or "key: value")
+ * once into a compile time sized table kept in caller provided (typically static) storage, so that later
+ * lookups take a bounded binary search instead of rescanning the string. It never allocates memory.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_static_index_H
+#define kv_static_index_H
+#include <stdint.h>
+
+/** Maximum number of distinct keys. Each entry costs 10 bytes. Override at compile time to size the table. */
+#ifndef KV_STATIC_INDEX_CAPACITY
+#define KV_STATIC_INDEX_CAPACITY 32
+#endif
+
+/** Largest indexed string, since offsets are 16 bit. */
+#define KV_STATIC_INDEX_STR_MAX 0xFFFFu
+/** Longest indexed key, since key lengths are 8 bit. */
+#define KV_STATIC_INDEX_KEY_MAX 0xFFu
+
+/**
+ * @brief Fixed capacity index over a key-value string.
+ *
+ * Laid out as parallel arrays (struct of arrays) so that the binary search only touches `hashes`.
+ * Entries are sorted by hash. Offsets are relative to `str`, which must outlive the index.
+ */
+typedef struct
+{
+    const char *str;                                  /**< Indexed string. */
+    uint16_t count;                                   /**< Number of distinct keys indexed. */
+    uint16_t hashes[KV_STATIC_INDEX_CAPACITY];        /**< 16 bit key hashes, in ascending order. */
+    uint16_t key_offsets[KV_STATIC_INDEX_CAPACITY];   /**< Offset of each key. */
+    uint16_t value_offsets[KV_STATIC_INDEX_CAPACITY]; /**< Offset of each value slice. */
+    uint16_t value_lens[KV_STATIC_INDEX_CAPACITY];    /**< Length of each value slice. */
+    uint8_t key_lens[KV_STATIC_INDEX_CAPACITY];       /**< Length of each key. */
+    uint8_t flags[KV_STATIC_INDEX_CAPACITY];          /**< `KV_VALUE_*` flags of each value slice (see kv_scan.h). */
+} kv_static_index;
+
+/**
+ * @brief Parses a key-value string once into a fixed capacity index.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Lines are parsed with the same rules as `kv_get_value()`. If a key appears more than once, the first
+ * occurrence is kept. Nothing is allocated; the whole table lives in `index`.
+ *
+ * @param index Index to fill. Usually a `static` variable.
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @return `0` on success, or `-1` if the string is longer than `KV_STATIC_INDEX_STR_MAX`, a key is longer than
+ *         `KV_STATIC_INDEX_KEY_MAX`, or there are more than `KV_STATIC_INDEX_CAPACITY` distinct keys.
+ *
+ * @example Usage Example:
+ * @code
+ * static kv_static_index index;
+ * char buffer[16];
+ * if (kv_static_index_build(&index, "baud=9600\nparity=none") == 0) {
+ *     unsigned int len = kv_static_index_get_value(&index, "baud", buffer, sizeof(buffer));
+ * }
+ * @endcode
+ */
+int kv_static_index_build(kv_static_index *index, const char *str);
+
+/**
+ * @brief Gets the value for a key from a fixed capacity index.
+ *
+ * Takes at most log2(`KV_STATIC_INDEX_CAPACITY`) hash compares, plus one key compare per entry sharing the key's 16 bit hash.
+ *
+ * Indexed keys end at a line's first delimiter, so a key containing `=` or `:` (e.g. `"a=b"` in `"a=b=1"`), or one with
+ * trailing whitespace, is instead found by scanning the string, exactly as `kv_get_value()` would.
+ *
+ * @param index Index built with `kv_static_index_build()`.
+ * @param key The key to search for.
+ * @param value Output buffer to store the extracted value.
+ * @param value_max Maximum length of the output buffer (`value`), including the null terminator.
+ * @return The length of the extracted value (excluding the null terminator) on success, or `0` if the key is not found or does not fit.
+ */
+unsigned int kv_static_index_get_value(const kv_static_index *index, const char *key, char *value, unsigned int value_max);
+#endif
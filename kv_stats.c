@@ -0,0 +1,32 @@
+/**
+ * @file kv_stats.c
+ * @brief Opt-in lookup instrumentation counters.
+ *
+ * This file contains per-thread counters that `kv_get_value()` and `kv_file_get_value()` update when the library
+ * is built with `KV_PARSE_STATS` defined. Without it the counting compiles to nothing.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_stats.h"
+#include <string.h>
+
+#ifdef KV_PARSE_STATS
+__thread kv_stats kv_stats_local;
+#endif
+
+void kv_stats_snapshot(kv_stats *stats)
+{
+#ifdef KV_PARSE_STATS
+    *stats = kv_stats_local;
+#else
+    memset(stats, 0, sizeof(*stats));
+#endif
+}
+
+void kv_stats_reset(void)
+{
+#ifdef KV_PARSE_STATS
+    memset(&kv_stats_local, 0, sizeof(kv_stats_local));
+#endif
+}
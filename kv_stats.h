@@ -0,0 +1,59 @@
+/**
+ * @file kv_stats.h
+ * @brief Opt-in lookup instrumentation counters.
+ *
+ * This file contains per-thread counters that `kv_get_value()` and `kv_file_get_value()` update when the library
+ * is built with `KV_PARSE_STATS` defined. Without it the counting compiles to nothing.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_stats_H
+#define kv_stats_H
+
+/**
+ * @brief Lookup counters of one thread.
+ */
+typedef struct
+{
+    unsigned long long bytes_scanned;   /**< Bytes of input read before the lookup returned. */
+    unsigned long long lines_skipped;   /**< Lines skipped because their key did not match. */
+    unsigned long long partial_matches; /**< Skipped lines whose key shared a prefix with the requested key. */
+    unsigned long long hits;            /**< Lookups that found the key and returned its value. */
+    unsigned long long misses;          /**< Lookups that did not find the key. */
+    unsigned long long truncated;       /**< Lookups that found the key but whose value did not fit the buffer. */
+} kv_stats;
+
+#ifdef KV_PARSE_STATS
+/** Counters of the calling thread. */
+extern __thread kv_stats kv_stats_local;
+#define KV_STATS_ADD(field, n) (kv_stats_local.field += (n))
+#else
+#define KV_STATS_ADD(field, n) ((void)0)
+#endif
+
+/**
+ * @brief Copies the calling thread's counters.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Counters are kept per thread so lookups never contend on them. Each thread takes its own snapshot.
+ * All counters read as zero if the library was built without `KV_PARSE_STATS`.
+ *
+ * @param stats Output counters.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_stats stats;
+ * kv_stats_reset();
+ * kv_get_value(config, "mode", buffer, sizeof(buffer));
+ * kv_stats_snapshot(&stats);
+ * printf("%llu bytes scanned\n", stats.bytes_scanned);
+ * @endcode
+ */
+void kv_stats_snapshot(kv_stats *stats);
+
+/**
+ * @brief Zeroes the calling thread's counters.
+ */
+void kv_stats_reset(void);
+#endif
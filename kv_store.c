@@ -0,0 +1,236 @@
+/**
+ * @file kv_store.c
+ * @brief Owned key-value store in a single arena.
+ *
+ * This file contains functions that load a formatted key-value string or file (e.g., "key=value" or "key: value")
+ * once into a single allocation holding a hash table, interned keys and unescaped values, freed with one call.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_store.h"
+#include "kv_index.h"
+#include "kv_scan.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Sizing pass: upper bounds of pairs and string bytes */
+typedef struct
+{
+    size_t pairs;
+    size_t bytes;
+    int too_large;
+} kv_store_size;
+
+/* Filling pass: the arena under construction */
+typedef struct
+{
+    kv_store *store;
+    char *strings;
+} kv_store_fill;
+
+static void kv_store_size_pair(kv_store_size *size, const kv_pair *pair)
+{
+    /* Values are unescaped through an unsigned int sized buffer */
+    if (pair->value_len >= UINT_MAX)
+    {
+        size->too_large = 1;
+    }
+    size->pairs++;
+    size->bytes += pair->key_len + 1 + pair->value_len + 1;
+}
+
+static void kv_store_fill_pair(kv_store_fill *fill, const kv_pair *pair)
+{
+    kv_store *store = fill->store;
+    const unsigned int hash = kv_index_hash(pair->key, pair->key_len);
+    const size_t mask = store->slot_count - 1;
+
+    size_t slot = hash & mask;
+    for (; store->slots[slot].key != NULL; slot = (slot + 1) & mask)
+    {
+        const kv_store_slot *entry = &store->slots[slot];
+        if (entry->hash == hash && entry->key_len == pair->key_len && memcmp(entry->key, pair->key, pair->key_len) == 0)
+        {
+            /* Duplicate Key. First occurrence wins. */
+            return;
+        }
+    }
+
+    /* Intern the key and store the unescaped value */
+    kv_store_slot *entry = &store->slots[slot];
+    memcpy(fill->strings, pair->key, pair->key_len);
+    fill->strings[pair->key_len] = '\0';
+    entry->key = fill->strings;
+    entry->key_len = pair->key_len;
+    fill->strings += pair->key_len + 1;
+
+    /* Sizing pass checked value_len < UINT_MAX */
+    const unsigned int value_max = (unsigned int)(pair->value_len + 1);
+    entry->value_len = kv_scan_unescape(pair->value, pair->value_len, pair->flags, fill->strings, value_max);
+    entry->value = fill->strings;
+    fill->strings += entry->value_len + 1;
+
+    entry->hash = hash;
+    store->count++;
+}
+
+/* Leaves the store empty, so lookups and kv_store_free() are safe after a failed load */
+static void kv_store_empty(kv_store *store)
+{
+    store->arena = NULL;
+    store->slots = NULL;
+    store->slot_count = 0;
+    store->count = 0;
+}
+
+/* Allocates the arena for the sized pairs */
+static int kv_store_alloc(kv_store *store, const kv_store_size *size, kv_store_fill *fill)
+{
+    store->count = 0;
+    store->slot_count = 4;
+    while (store->slot_count < size->pairs * 2)
+    {
+        store->slot_count *= 2;
+    }
+
+    const size_t slots_size = store->slot_count * sizeof(kv_store_slot);
+    store->arena = malloc(slots_size + size->bytes);
+    if (store->arena == NULL)
+    {
+        return -1;
+    }
+
+    store->slots = store->arena;
+    memset(store->slots, 0, slots_size);
+    fill->store = store;
+    fill->strings = (char *)store->arena + slots_size;
+    return 0;
+}
+
+/* Sizes and fills the store from [str, end), or up to the NUL terminator if end is NULL. Both passes see the same bytes. */
+static int kv_store_load_range(kv_store *store, const char *str, const char *end)
+{
+    kv_store_size size = {0, 0, 0};
+    for (const char *line = str; end ? line < end : *line != '\0';)
+    {
+        kv_pair pair;
+        line = kv_scan_pair(line, end, &pair);
+        if (pair.key != NULL)
+        {
+            kv_store_size_pair(&size, &pair);
+        }
+    }
+
+    kv_store_fill fill;
+    if (size.too_large || kv_store_alloc(store, &size, &fill) != 0)
+    {
+        kv_store_empty(store);
+        return -1;
+    }
+
+    for (const char *line = str; end ? line < end : *line != '\0';)
+    {
+        kv_pair pair;
+        line = kv_scan_pair(line, end, &pair);
+        if (pair.key != NULL)
+        {
+            kv_store_fill_pair(&fill, &pair);
+        }
+    }
+    return 0;
+}
+
+int kv_store_load(kv_store *store, const char *str)
+{
+    return kv_store_load_range(store, str, NULL);
+}
+
+int kv_store_load_file(kv_store *store, FILE *file)
+{
+    /* Read the file once, so a file that changes while loading cannot overrun the arena sized from it */
+    char *buf = NULL;
+    size_t len = 0;
+    size_t buf_size = 0;
+    rewind(file);
+    for (;;)
+    {
+        if (len == buf_size)
+        {
+            const size_t grown_size = buf_size ? buf_size * 2 : 4096;
+            char *grown = realloc(buf, grown_size);
+            if (grown == NULL)
+            {
+                free(buf);
+                kv_store_empty(store);
+                return -1;
+            }
+            buf = grown;
+            buf_size = grown_size;
+        }
+
+        const size_t n = fread(buf + len, 1, buf_size - len, file);
+        len += n;
+        if (n == 0)
+        {
+            break;
+        }
+    }
+
+    const int ret = ferror(file) ? -1 : kv_store_load_range(store, buf, buf + len);
+    if (ret != 0)
+    {
+        kv_store_empty(store);
+    }
+    free(buf);
+    return ret;
+}
+
+void kv_store_free(kv_store *store)
+{
+    free(store->arena);
+    kv_store_empty(store);
+}
+
+static const kv_store_slot *kv_store_find(const kv_store *store, const char *key)
+{
+    if (store->slot_count == 0)
+    {
+        return NULL;
+    }
+
+    const size_t key_len = strlen(key);
+    const unsigned int hash = kv_index_hash(key, key_len);
+    const size_t mask = store->slot_count - 1;
+    for (size_t slot = hash & mask; store->slots[slot].key != NULL; slot = (slot + 1) & mask)
+    {
+        const kv_store_slot *entry = &store->slots[slot];
+        if (entry->hash == hash && entry->key_len == key_len && memcmp(entry->key, key, key_len) == 0)
+        {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+const char *kv_store_get(const kv_store *store, const char *key, size_t *value_len)
+{
+    const kv_store_slot *entry = kv_store_find(store, key);
+    if (entry == NULL)
+    {
+        return NULL;
+    }
+
+    if (value_len != NULL)
+    {
+        *value_len = entry->value_len;
+    }
+    return entry->value;
+}
+
+const char *kv_store_intern(const kv_store *store, const char *key)
+{
+    const kv_store_slot *entry = kv_store_find(store, key);
+    return entry ? entry->key : NULL;
+}
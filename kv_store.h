@@ -0,0 +1,102 @@
+/**
+ * @file kv_store.h
+ * @brief Owned key-value store in a single arena.
+ *
+ * This file contains functions that load a formatted key-value string or file (e.g., "key=value" or "key: value")
+ * once into a single allocation holding a hash table, interned keys and unescaped values, freed with one call.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_store_H
+#define kv_store_H
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * @brief One hash slot. An empty slot has `key == NULL`.
+ */
+typedef struct
+{
+    const char *key;   /**< Interned NUL terminated key in the arena. */
+    const char *value; /**< NUL terminated value in the arena, quotes resolved. */
+    size_t key_len;    /**< Length of the key. */
+    size_t value_len;  /**< Length of the value. */
+    unsigned int hash; /**< Hash of the key. */
+} kv_store_slot;
+
+/**
+ * @brief Key-value store owning all of its keys and values.
+ *
+ * The slot table and all strings live in one allocation (`arena`), so results stay valid until `kv_store_free()`.
+ */
+typedef struct
+{
+    void *arena;           /**< The single allocation backing the store. */
+    kv_store_slot *slots;  /**< Hash slots, at the start of the arena. */
+    size_t slot_count;     /**< Number of slots. A power of two. */
+    size_t count;          /**< Number of keys. */
+} kv_store;
+
+/**
+ * @brief Loads every pair of a key-value string into a new store.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Lines are parsed with the same rules as `kv_get_value()`: first occurrence wins and values are stored with quotes
+ * resolved. The string is scanned twice (once to size the arena) and can be freed once this returns.
+ *
+ * @param store Store to initialise.
+ * @param str Input string containing multiple key-value pairs (e.g., `"key=value"`) separated by newline.
+ * @return `0` on success, or `-1` if the arena could not be allocated or a value is longer than `UINT_MAX - 1`.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_store store;
+ * if (kv_store_load(&store, "username=admin\npassword=1234") == 0) {
+ *     const char *user = kv_store_get(&store, "username", NULL);
+ *     kv_store_free(&store);
+ * }
+ * @endcode
+ */
+int kv_store_load(kv_store *store, const char *str);
+
+/**
+ * @brief Loads every pair of a key-value file into a new store.
+ *
+ * The file is read into memory once from the start, then loaded with the same rules as `kv_store_load()`,
+ * so a file that changes during the load gives a consistent store of what was read.
+ *
+ * @param store Store to initialise.
+ * @param file Input file stream containing key-value pairs (e.g., "key=value") separated by newline.
+ * @return `0` on success, or `-1` if the file could not be read or the arena could not be allocated.
+ */
+int kv_store_load_file(kv_store *store, FILE *file);
+
+/**
+ * @brief Frees the store's arena. Every pointer returned by the store becomes invalid.
+ *
+ * @param store Store loaded with `kv_store_load()` or `kv_store_load_file()`.
+ */
+void kv_store_free(kv_store *store);
+
+/**
+ * @brief Gets a value from the store without copying.
+ *
+ * @param store Loaded store.
+ * @param key The key to search for.
+ * @param value_len Output length of the value. May be `NULL`.
+ * @return The NUL terminated value, or `NULL` if the key is not found. Valid until `kv_store_free()`.
+ */
+const char *kv_store_get(const kv_store *store, const char *key, size_t *value_len);
+
+/**
+ * @brief Gets the store's interned copy of a key.
+ *
+ * Interned keys are unique, so two keys from the same store are equal exactly when their pointers are equal.
+ *
+ * @param store Loaded store.
+ * @param key The key to search for.
+ * @return The interned key, or `NULL` if the key is not in the store. Valid until `kv_store_free()`.
+ */
+const char *kv_store_intern(const kv_store *store, const char *key);
+#endif
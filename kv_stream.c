@@ -0,0 +1,220 @@
+/**
+ * @file kv_stream.c
+ * @brief Push style key-value parser for chunked input.
+ *
+ * This file contains a resumable parser that accepts a formatted key-value stream (e.g., "key=value" or "key: value")
+ * in arbitrary chunks, such as reads from a pipe or socket, and reports each pair through a callback.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_stream.h"
+#include <string.h>
+
+enum
+{
+    KV_STREAM_LINE_START,
+    KV_STREAM_KEY,
+    KV_STREAM_VALUE_START,
+    KV_STREAM_VALUE,
+    KV_STREAM_SKIP_LINE
+};
+
+void kv_stream_init(kv_stream *stream, const char *key, char *key_buf, size_t key_max, char *value_buf, size_t value_max, kv_stream_cb cb, void *ctx)
+{
+    memset(stream, 0, sizeof(*stream));
+    stream->cb = cb;
+    stream->ctx = ctx;
+    stream->key = key;
+    stream->key_buf = key_buf;
+    stream->key_max = key_max;
+    stream->value_buf = value_buf;
+    stream->value_max = value_max;
+    stream->state = KV_STREAM_LINE_START;
+}
+
+/* Reports the current pair. Returns non zero if the callback asked to stop. */
+static int kv_stream_emit(kv_stream *stream, size_t value_len)
+{
+    if (value_len >= stream->value_max)
+    {
+        /* Value too large for buffer. Don't report a value. */
+        stream->dropped++;
+        return 0;
+    }
+
+    stream->key_buf[stream->key_trim] = '\0';
+    stream->value_buf[value_len] = '\0';
+
+    kv_pair pair;
+    pair.key = stream->key_buf;
+    pair.key_len = stream->key_trim;
+    pair.value = stream->value_buf;
+    pair.value_len = value_len;
+    pair.flags = stream->flags;
+    stream->stopped = stream->cb(stream->ctx, &pair) != 0;
+    return stream->stopped;
+}
+
+int kv_stream_feed(kv_stream *stream, const char *data, size_t len)
+{
+    for (size_t i = 0; i < len && !stream->stopped; i++)
+    {
+        const char ch = data[i];
+        switch (stream->state)
+        {
+            case KV_STREAM_LINE_START:
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                if (ch == ' ' || ch == '\t')
+                {
+                    break;
+                }
+#endif
+                stream->key_len = 0;
+                stream->key_trim = 0;
+                stream->state = KV_STREAM_KEY;
+                /* fall through */
+
+            case KV_STREAM_KEY:
+                if (ch == '\n')
+                {
+                    /* No delimiter on this line */
+                    stream->state = KV_STREAM_LINE_START;
+                    break;
+                }
+
+                if (ch == '=' || ch == ':')
+                {
+                    /* Check For Key */
+                    if (stream->key_trim >= stream->key_max)
+                    {
+                        /* Key too large for buffer. Skip Line */
+                        stream->dropped++;
+                        stream->state = KV_STREAM_SKIP_LINE;
+                        break;
+                    }
+
+                    stream->key_buf[stream->key_trim] = '\0';
+                    if (stream->key != NULL && strcmp(stream->key, stream->key_buf) != 0)
+                    {
+                        /* Key Mismatched. Skip Line */
+                        stream->state = KV_STREAM_SKIP_LINE;
+                        break;
+                    }
+
+                    stream->value_len = 0;
+                    stream->value_trim = 0;
+                    stream->quote = 0;
+                    stream->prev = 0;
+                    stream->flags = 0;
+                    stream->state = KV_STREAM_VALUE_START;
+                    break;
+                }
+
+                if (stream->key_len < stream->key_max)
+                {
+                    stream->key_buf[stream->key_len] = ch;
+                }
+                stream->key_len++;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                if (ch != ' ' && ch != '\t')
+                {
+                    stream->key_trim = stream->key_len;
+                }
+#else
+                stream->key_trim = stream->key_len;
+#endif
+                break;
+
+            case KV_STREAM_VALUE_START:
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                if (ch == ' ' || ch == '\t')
+                {
+                    break;
+                }
+#endif
+                stream->state = KV_STREAM_VALUE;
+                /* fall through */
+
+            case KV_STREAM_VALUE:
+                if (ch == '\r' || ch == '\n')
+                {
+                    /* End Of Line. Trim trailing whitespace before reporting the value. */
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+                    kv_stream_emit(stream, stream->value_trim);
+#else
+                    kv_stream_emit(stream, stream->value_len);
+#endif
+                    stream->state = ch == '\n' ? KV_STREAM_LINE_START : KV_STREAM_SKIP_LINE;
+                    break;
+                }
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+                else if (stream->quote == 0 && (ch == '\'' || ch == '"'))
+                {
+                    /* Start Of Quoted String */
+                    stream->quote = ch;
+                    stream->prev = ch;
+                    stream->flags |= KV_VALUE_QUOTED;
+                    break;
+                }
+                else if (stream->quote != 0 && stream->prev != '\\' && ch == stream->quote)
+                {
+                    /* End Of Quoted String. Report Value */
+                    kv_stream_emit(stream, stream->value_len);
+                    stream->state = KV_STREAM_SKIP_LINE;
+                    break;
+                }
+                else if (stream->quote != 0 && stream->prev == '\\' && ch == stream->quote)
+                {
+                    /* Escaped Quote Character In Quoted String */
+                    if (stream->value_len - 1 < stream->value_max)
+                    {
+                        stream->value_buf[stream->value_len - 1] = ch;
+                    }
+                    stream->value_trim = stream->value_len;
+                    stream->prev = ch;
+                    break;
+                }
+
+                stream->prev = ch;
+#endif
+
+                if (stream->value_len < stream->value_max)
+                {
+                    stream->value_buf[stream->value_len] = ch;
+                }
+                stream->value_len++;
+                if (ch != ' ' && ch != '\t')
+                {
+                    stream->value_trim = stream->value_len;
+                }
+                break;
+
+            case KV_STREAM_SKIP_LINE:
+                /* Search for start of next line */
+                if (ch == '\n')
+                {
+                    stream->state = KV_STREAM_LINE_START;
+                }
+                break;
+        }
+    }
+
+    return stream->stopped;
+}
+
+int kv_stream_finish(kv_stream *stream)
+{
+    if (!stream->stopped && (stream->state == KV_STREAM_VALUE_START || stream->state == KV_STREAM_VALUE))
+    {
+        /* End of input. Trim trailing whitespace before reporting the value. */
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        kv_stream_emit(stream, stream->value_trim);
+#else
+        kv_stream_emit(stream, stream->value_len);
+#endif
+    }
+
+    stream->state = KV_STREAM_LINE_START;
+    return stream->stopped;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file kv_stream.h
+ * @brief Push style key-value parser for chunked input.
+ *
+ * This file contains a resumable parser that accepts a formatted key-value stream (e.g., "key=value" or "key: value")
+ * in arbitrary chunks, such as reads from a pipe or socket, and reports each pair through a callback.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_stream_H
+#define kv_stream_H
+#include "kv_scan.h"
+#include <stddef.h>
+
+/**
+ * @brief Called for each key-value pair.
+ *
+ * `pair->key` and `pair->value` point into the stream's own buffers and are NUL terminated. Quotes are
+ * already resolved, so `KV_VALUE_ESCAPED` is never set. They are only valid during the call.
+ *
+ * @param ctx Caller context given to `kv_stream_init()`.
+ * @param pair The key-value pair.
+ * @return `0` to continue, or non zero to stop the stream.
+ */
+typedef int (*kv_stream_cb)(void *ctx, const kv_pair *pair);
+
+/**
+ * @brief Parser state. Its size does not depend on the amount of input.
+ */
+typedef struct
+{
+    kv_stream_cb cb;         /**< Pair callback. */
+    void *ctx;               /**< Caller context passed to `cb`. */
+    const char *key;         /**< Only report this key, or `NULL` to report every pair. */
+    char *key_buf;           /**< Caller provided key buffer. */
+    size_t key_max;          /**< Size of `key_buf`, including the null terminator. */
+    char *value_buf;         /**< Caller provided value buffer. */
+    size_t value_max;        /**< Size of `value_buf`, including the null terminator. */
+    int state;               /**< Current parser state. */
+    size_t key_len;          /**< Key characters seen on this line. */
+    size_t key_trim;         /**< Key length excluding trailing whitespace. */
+    size_t value_len;        /**< Value characters seen on this line. */
+    size_t value_trim;       /**< Value length excluding trailing whitespace. */
+    int quote;               /**< Open quote character, or `0`. */
+    int prev;                /**< Previous value character, for escaped quotes. */
+    unsigned int flags;      /**< `KV_VALUE_*` flags of the current value. */
+    int stopped;             /**< Set once the callback asked to stop. */
+    unsigned long dropped;   /**< Pairs skipped because the key or value did not fit its buffer. */
+} kv_stream;
+
+/**
+ * @brief Initialises a streaming parser.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * Lines are parsed with the same whitespace, delimiter, quote and escape rules as `kv_get_value()`. All state lives
+ * in `stream` and the two caller provided buffers, whatever the size of the input.
+ *
+ * @param stream Parser to initialise.
+ * @param key Only report pairs with this key, or `NULL` to report every pair.
+ * @param key_buf Buffer for the key of the current line. Longer keys are skipped.
+ * @param key_max Size of `key_buf`, including the null terminator.
+ * @param value_buf Buffer for the value of the current line. Longer values are skipped, like `kv_get_value()`.
+ * @param value_max Size of `value_buf`, including the null terminator.
+ * @param cb Callback fired for each pair.
+ * @param ctx Caller context passed to `cb`.
+ *
+ * @example Usage Example:
+ * @code
+ * char key[64], value[256];
+ * kv_stream stream;
+ * kv_stream_init(&stream, NULL, key, sizeof(key), value, sizeof(value), on_pair, NULL);
+ * while ((n = read(fd, chunk, sizeof(chunk))) > 0) {
+ *     if (kv_stream_feed(&stream, chunk, n)) break;
+ * }
+ * kv_stream_finish(&stream);
+ * @endcode
+ */
+void kv_stream_init(kv_stream *stream, const char *key, char *key_buf, size_t key_max, char *value_buf, size_t value_max, kv_stream_cb cb, void *ctx);
+
+/**
+ * @brief Feeds the next chunk of input to the parser.
+ *
+ * @param stream Parser initialised with `kv_stream_init()`.
+ * @param data Next chunk of input. Need not be NUL terminated or end on a line boundary.
+ * @param len Length of `data`.
+ * @return `0` to keep feeding, or `1` if the callback stopped the stream.
+ */
+int kv_stream_feed(kv_stream *stream, const char *data, size_t len);
+
+/**
+ * @brief Ends the input, reporting a last line that has no trailing newline.
+ *
+ * @param stream Parser initialised with `kv_stream_init()`.
+ * @return `0`, or `1` if the callback stopped the stream.
+ */
+int kv_stream_finish(kv_stream *stream);
+#endif
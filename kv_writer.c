@@ -0,0 +1,417 @@
+/**
+ * @file kv_writer.c
+ * @brief Batched key-value file updates with atomic replacement.
+ *
+ * This file contains functions that set or delete keys in a formatted key-value file (e.g., "key=value" or "key: value")
+ * following the same parsing rules as `kv_get_value()`. Updates are collected in a transaction and applied in one
+ * streaming pass into a temporary file, which is flushed to disk and renamed over the original.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#define _XOPEN_SOURCE 700 /* realpath() */
+
+#include "kv_writer.h"
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* Output file, remembering the last character written */
+typedef struct
+{
+    FILE *out;
+    int last;
+} kv_writer;
+
+static void kv_writer_putc(kv_writer *w, int ch)
+{
+    putc(ch, w->out);
+    w->last = ch;
+}
+
+static void kv_writer_write(kv_writer *w, const char *str, size_t len)
+{
+    for (size_t i = 0; i < len; i++)
+    {
+        kv_writer_putc(w, str[i]);
+    }
+}
+
+/* Returns 1 if the value must be quoted to read back unchanged, 0 if not, or -1 if it cannot be written */
+static int kv_writer_value_quoting(const char *value)
+{
+    if (strpbrk(value, "\r\n") != NULL)
+    {
+        return -1;
+    }
+    const size_t len = strlen(value);
+
+    int quote = 0;
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    /* A quote anywhere starts a quoted string */
+    quote = strpbrk(value, "\"'") != NULL;
+#endif
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    /* Leading and trailing whitespace would be skipped */
+    quote = quote || (len > 0 && (value[0] == ' ' || value[0] == '\t' || value[len - 1] == ' ' || value[len - 1] == '\t'));
+#endif
+
+#ifdef KV_PARSE_DISABLE_QUOTED_STRINGS
+    (void)len;
+    return quote ? -1 : 0;
+#else
+    /* A trailing backslash would escape the closing quote */
+    return (quote && len > 0 && value[len - 1] == '\\') ? -1 : quote;
+#endif
+}
+
+static void kv_writer_value(kv_writer *w, const char *value)
+{
+    if (kv_writer_value_quoting(value) == 0)
+    {
+        kv_writer_write(w, value, strlen(value));
+        return;
+    }
+
+    /* Quoted String. Escape Quote Characters. */
+    kv_writer_putc(w, '"');
+    for (; *value != '\0'; value++)
+    {
+        if (*value == '"')
+        {
+            kv_writer_putc(w, '\\');
+        }
+        kv_writer_putc(w, *value);
+    }
+    kv_writer_putc(w, '"');
+}
+
+static int kv_writer_key_valid(const char *key)
+{
+    const size_t len = strlen(key);
+    if (len == 0 || strpbrk(key, "=:\r\n") != NULL)
+    {
+        return 0;
+    }
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    if (key[0] == ' ' || key[0] == '\t' || key[len - 1] == ' ' || key[len - 1] == '\t')
+    {
+        return 0;
+    }
+#endif
+    return 1;
+}
+
+/* Finds the update of a key given as a slice */
+static kv_edit *kv_writer_find(kv_txn *txn, const char *key, size_t key_len)
+{
+    for (size_t e = 0; e < txn->count; e++)
+    {
+        if (strncmp(txn->edits[e].key, key, key_len) == 0 && txn->edits[e].key[key_len] == '\0')
+        {
+            return &txn->edits[e];
+        }
+    }
+    return NULL;
+}
+
+static int kv_txn_add(kv_txn *txn, const char *key, const char *value)
+{
+    kv_edit *edit = kv_writer_find(txn, key, strlen(key));
+    if (edit == NULL)
+    {
+        if (txn->count >= txn->max)
+        {
+            return -1;
+        }
+        edit = &txn->edits[txn->count++];
+    }
+
+    /* Later updates of the same key replace earlier ones */
+    edit->key = key;
+    edit->value = value;
+    edit->applied = 0;
+    return 0;
+}
+
+void kv_txn_init(kv_txn *txn, kv_edit *edits, size_t max)
+{
+    txn->edits = edits;
+    txn->count = 0;
+    txn->max = max;
+}
+
+int kv_txn_set(kv_txn *txn, const char *key, const char *value)
+{
+    if (!kv_writer_key_valid(key) || kv_writer_value_quoting(value) < 0)
+    {
+        return -1;
+    }
+    return kv_txn_add(txn, key, value);
+}
+
+int kv_txn_delete(kv_txn *txn, const char *key)
+{
+    if (!kv_writer_key_valid(key))
+    {
+        return -1;
+    }
+    return kv_txn_add(txn, key, NULL);
+}
+
+/* Copies the rest of the line, including its newline */
+static int kv_writer_copy_line(kv_writer *w, FILE *in, int ch)
+{
+    for (; ch != EOF; ch = getc(in))
+    {
+        kv_writer_putc(w, ch);
+        if (ch == '\n')
+        {
+            return getc(in);
+        }
+    }
+    return EOF;
+}
+
+/* Streams `in` (which may be NULL for a missing file) to the writer, applying the updates */
+static void kv_writer_rewrite(kv_txn *txn, FILE *in, kv_writer *w)
+{
+    int ch = in ? getc(in) : EOF;
+    while (ch != EOF)
+    {
+        /* Read Line Up To Key Value Delimiter */
+        char prefix[KV_WRITER_PREFIX_MAX];
+        size_t prefix_len = 0;
+        while (ch != EOF && ch != '\n' && ch != '=' && ch != ':' && prefix_len < sizeof(prefix))
+        {
+            prefix[prefix_len++] = ch;
+            ch = getc(in);
+        }
+
+        if (ch != '=' && ch != ':')
+        {
+            /* No delimiter, or key too long to be updated. Copy Line */
+            kv_writer_write(w, prefix, prefix_len);
+            ch = kv_writer_copy_line(w, in, ch);
+            continue;
+        }
+
+        /* Find Key */
+        const char *key = prefix;
+        const char *key_end = prefix + prefix_len;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (key < key_end && (*key == ' ' || *key == '\t'))
+        {
+            key++;
+        }
+        while (key_end > key && (key_end[-1] == ' ' || key_end[-1] == '\t'))
+        {
+            key_end--;
+        }
+#endif
+
+        kv_edit *edit = kv_writer_find(txn, key, key_end - key);
+        if (edit == NULL || (edit->value != NULL && edit->applied))
+        {
+            /* Not updated, or a later duplicate of a key already set. Copy Line */
+            kv_writer_write(w, prefix, prefix_len);
+            ch = kv_writer_copy_line(w, in, ch);
+            continue;
+        }
+
+        edit->applied = 1;
+        if (edit->value == NULL)
+        {
+            /* Delete Line */
+            while (ch != EOF && ch != '\n')
+            {
+                ch = getc(in);
+            }
+            ch = (ch == EOF) ? EOF : getc(in);
+            continue;
+        }
+
+        /* Replace Value, keeping the key, delimiter and whitespace layout */
+        kv_writer_write(w, prefix, prefix_len);
+        kv_writer_putc(w, ch);
+        ch = getc(in);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        while (ch == ' ' || ch == '\t')
+        {
+            kv_writer_putc(w, ch);
+            ch = getc(in);
+        }
+#endif
+        kv_writer_value(w, edit->value);
+
+        /* Skip Old Value, keeping the line ending */
+        int prev = EOF;
+        while (ch != EOF && ch != '\n')
+        {
+            prev = ch;
+            ch = getc(in);
+        }
+        if (ch == '\n')
+        {
+            if (prev == '\r')
+            {
+                kv_writer_putc(w, '\r');
+            }
+            kv_writer_putc(w, '\n');
+            ch = getc(in);
+        }
+    }
+
+    /* Append Keys Not Found */
+    for (size_t e = 0; e < txn->count; e++)
+    {
+        kv_edit *edit = &txn->edits[e];
+        if (edit->applied || edit->value == NULL)
+        {
+            continue;
+        }
+
+        if (w->last != '\n' && w->last != EOF)
+        {
+            kv_writer_putc(w, '\n');
+        }
+        kv_writer_write(w, edit->key, strlen(edit->key));
+        kv_writer_putc(w, '=');
+        kv_writer_value(w, edit->value);
+        kv_writer_putc(w, '\n');
+        edit->applied = 1;
+    }
+}
+
+/* Flushes the directory entry of `path` to disk, so a rename into it survives a crash */
+static int kv_writer_sync_dir(const char *path)
+{
+    const char *slash = strrchr(path, '/');
+    const size_t len = slash == NULL ? 0 : (slash == path ? 1 : (size_t)(slash - path));
+    char dir[len + sizeof(".")];
+    if (slash == NULL)
+    {
+        strcpy(dir, ".");
+    }
+    else
+    {
+        memcpy(dir, path, len);
+        dir[len] = '\0';
+    }
+
+    const int fd = open(dir, O_RDONLY);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    const int failed = fsync(fd) != 0;
+    close(fd);
+    return failed ? -1 : 0;
+}
+
+/* Rewrites the regular file at `path` through a temporary file renamed over it */
+static int kv_writer_replace(kv_txn *txn, const char *path)
+{
+    FILE *in = fopen(path, "rb");
+    if (in == NULL && errno != ENOENT)
+    {
+        return -1;
+    }
+
+    /* Temporary file in the same directory, so the rename stays on one filesystem */
+    char tmp_path[strlen(path) + sizeof(".XXXXXX")];
+    strcpy(tmp_path, path);
+    strcat(tmp_path, ".XXXXXX");
+    const int fd = mkstemp(tmp_path);
+    if (fd < 0)
+    {
+        if (in != NULL)
+        {
+            fclose(in);
+        }
+        return -1;
+    }
+
+    /* Keep the owner, then the mode (a change of owner may clear the set-id bits) */
+    struct stat st;
+    int failed = 0;
+    if (in != NULL)
+    {
+        failed = fstat(fileno(in), &st) != 0;
+        if (!failed && (st.st_uid != geteuid() || st.st_gid != getegid()))
+        {
+            failed = fchown(fd, st.st_uid, st.st_gid) != 0;
+        }
+    }
+    failed = failed || fchmod(fd, in != NULL ? (st.st_mode & 07777) : 0644) != 0;
+
+    kv_writer w = {failed ? NULL : fdopen(fd, "wb"), EOF};
+    if (w.out == NULL)
+    {
+        close(fd);
+        unlink(tmp_path);
+        if (in != NULL)
+        {
+            fclose(in);
+        }
+        return -1;
+    }
+
+    kv_writer_rewrite(txn, in, &w);
+
+    failed = (in != NULL && ferror(in));
+    if (in != NULL)
+    {
+        fclose(in);
+    }
+    failed |= fflush(w.out) != 0 || ferror(w.out) || fsync(fd) != 0;
+    failed |= fclose(w.out) != 0;
+    if (failed || rename(tmp_path, path) != 0)
+    {
+        unlink(tmp_path);
+        return -1;
+    }
+    return kv_writer_sync_dir(path);
+}
+
+int kv_txn_commit(kv_txn *txn, const char *path)
+{
+    for (size_t e = 0; e < txn->count; e++)
+    {
+        txn->edits[e].applied = 0;
+    }
+
+    /* Replace the file a symbolic link points to, not the link. A missing file is created at `path`. */
+    char *resolved = realpath(path, NULL);
+    const int result = kv_writer_replace(txn, resolved != NULL ? resolved : path);
+    free(resolved);
+    return result;
+}
+
+int kv_set_value(const char *path, const char *key, const char *value)
+{
+    kv_edit edit;
+    kv_txn txn;
+    kv_txn_init(&txn, &edit, 1);
+    if (kv_txn_set(&txn, key, value) != 0)
+    {
+        return -1;
+    }
+    return kv_txn_commit(&txn, path);
+}
+
+int kv_delete_key(const char *path, const char *key)
+{
+    kv_edit edit;
+    kv_txn txn;
+    kv_txn_init(&txn, &edit, 1);
+    if (kv_txn_delete(&txn, key) != 0)
+    {
+        return -1;
+    }
+    return kv_txn_commit(&txn, path);
+}
@@ -0,0 +1,127 @@
+/**
+ * @file kv_writer.h
+ * @brief Batched key-value file updates with atomic replacement.
+ *
+ * This file contains functions that set or delete keys in a formatted key-value file (e.g., "key=value" or "key: value")
+ * following the same parsing rules as `kv_get_value()`. Updates are collected in a transaction and applied in one
+ * streaming pass into a temporary file, which is flushed to disk and renamed over the original.
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+#ifndef kv_writer_H
+#define kv_writer_H
+#include <stddef.h>
+
+/** Longest line prefix (up to the delimiter) examined for a key. Lines with longer prefixes are copied unchanged. */
+#ifndef KV_WRITER_PREFIX_MAX
+#define KV_WRITER_PREFIX_MAX 256
+#endif
+
+/**
+ * @brief One pending update.
+ */
+typedef struct
+{
+    const char *key;   /**< Key to update. */
+    const char *value; /**< New value, or `NULL` to delete the key. */
+    int applied;       /**< Set once the update has been written. */
+} kv_edit;
+
+/**
+ * @brief Set of updates applied together by `kv_txn_commit()`.
+ *
+ * Keys and values are not copied. They must stay valid until the transaction is committed.
+ */
+typedef struct
+{
+    kv_edit *edits; /**< Caller provided edit storage. */
+    size_t count;   /**< Number of edits. */
+    size_t max;     /**< Number of entries in `edits`. */
+} kv_txn;
+
+/**
+ * @brief Starts an empty transaction.
+ *
+ * @param txn Transaction to initialise.
+ * @param edits Edit storage. One entry per distinct key updated.
+ * @param max Number of entries in `edits`.
+ */
+void kv_txn_init(kv_txn *txn, kv_edit *edits, size_t max);
+
+/**
+ * @brief Adds or replaces the update of a key with a new value.
+ *
+ * Values that would not read back unchanged are quoted and escaped as `kv_get_value()` expects.
+ * Values containing a newline or carriage return cannot be stored.
+ *
+ * @param txn Transaction.
+ * @param key Key to set. Must not contain `=`, `:` or a line break, nor (with whitespace skipping) start or end with whitespace.
+ * @param value New value.
+ * @return `0` on success, or `-1` if the key or value cannot be written, or the transaction is full.
+ */
+int kv_txn_set(kv_txn *txn, const char *key, const char *value);
+
+/**
+ * @brief Adds or replaces the update of a key with its deletion.
+ *
+ * Every line holding the key is removed, so later duplicates do not come back into effect.
+ *
+ * @param txn Transaction.
+ * @param key Key to delete.
+ * @return `0` on success, or `-1` if the key is invalid or the transaction is full.
+ */
+int kv_txn_delete(kv_txn *txn, const char *key);
+
+/**
+ * @brief Applies every update of a transaction to a file in one pass.
+ *
+ * 2025 Brian Khuu https://briankhuu.com/ (This function is dedicated to Public Domain)
+ *
+ * The file is streamed into a temporary file in the same directory. The first line holding each set key has its value
+ * replaced, keeping the surrounding formatting and line ending. Keys not found are appended as `key=value` lines.
+ * The temporary file is `fsync()`ed and renamed over `path`, so readers see either the old or the new file, and the
+ * directory is `fsync()`ed after the rename so the replacement survives a crash.
+ * A missing file is created (mode 0644); an existing file keeps its mode, owner and group. Keeping another user's
+ * ownership needs the privilege to `fchown()` to it, otherwise the commit fails.
+ * If `path` is a symbolic link, the file it points to is replaced and the link is kept. The replacement is a new
+ * file, so hard links to the old file keep the old contents.
+ *
+ * @param txn Transaction.
+ * @param path Path of the key-value file.
+ * @return `0` on success, or `-1` on an I/O error, in which case the original file is untouched. If only the final
+ *         directory `fsync()` fails, the file has already been replaced but may not survive a crash.
+ *
+ * @example Usage Example:
+ * @code
+ * kv_edit edits[8];
+ * kv_txn txn;
+ * kv_txn_init(&txn, edits, 8);
+ * kv_txn_set(&txn, "mode", "fast");
+ * kv_txn_set(&txn, "greeting", "  hello  ");
+ * kv_txn_delete(&txn, "legacy");
+ * if (kv_txn_commit(&txn, "app.conf") != 0) {
+ *     printf("Update failed.\n");
+ * }
+ * @endcode
+ */
+int kv_txn_commit(kv_txn *txn, const char *path);
+
+/**
+ * @brief Sets one key in a file. Same as a transaction with a single `kv_txn_set()`.
+ *
+ * @param path Path of the key-value file.
+ * @param key Key to set.
+ * @param value New value.
+ * @return `0` on success, or `-1` on failure.
+ */
+int kv_set_value(const char *path, const char *key, const char *value);
+
+/**
+ * @brief Deletes one key from a file. Same as a transaction with a single `kv_txn_delete()`.
+ *
+ * @param path Path of the key-value file.
+ * @param key Key to delete.
+ * @return `0` on success, or `-1` on failure.
+ */
+int kv_delete_key(const char *path, const char *key);
+#endif
@@ -0,0 +1,31 @@
+/**
+ * @file kvc.c
+ * @brief Key-value image compiler.
+ *
+ * Compiles a formatted key-value text file (e.g., "key=value" or "key: value") into a binary image for `kv_compiled_open()`.
+ * Build it with the same `KV_PARSE_DISABLE_*` flags as the programs that load the image.
+ *
+ * Usage: kvc <input.kv> <output.kvc>
+ *
+ * This code is released to the public domain by Brian Khuu in 2025.
+ */
+
+#include "kv_compiled.h"
+#include <stdio.h>
+
+int main(int argc, char *argv[])
+{
+    if (argc != 3)
+    {
+        fprintf(stderr, "Usage: %s <input.kv> <output.kvc>\n", argv[0]);
+        return 2;
+    }
+
+    if (kv_compile_path(argv[1], argv[2]) != 0)
+    {
+        fprintf(stderr, "%s: could not compile %s to %s\n", argv[0], argv[1], argv[2]);
+        return 1;
+    }
+
+    return 0;
+}
@@ -1,8 +1,36 @@
+#define _POSIX_C_SOURCE 200809L
+
+#include "kv_bulk.h"
+#include "kv_compiled.h"
+#include "kv_file_cache.h"
 #include "kv_file_get_value.h"
+#include "kv_foreach.h"
+#include "kv_get_typed.h"
 #include "kv_get_value.h"
+#include "kv_get_value_variants.h"
+#include "kv_get_value_view.h"
+#include "kv_index.h"
+#include "kv_index_parallel.h"
+#include "kv_key.h"
+#include "kv_keys.h"
+#include "kv_mapped_file.h"
+#include "kv_records.h"
+#include "kv_section.h"
+#include "kv_seek_index.h"
+#include "kv_snapshot.h"
+#include "kv_sorted.h"
+#include "kv_static_index.h"
+#include "kv_stats.h"
+#include "kv_store.h"
+#include "kv_stream.h"
+#include "kv_writer.h"
 #include <assert.h>
+#include <fcntl.h>
+#include <pthread.h>
 #include <stdio.h>
 #include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
 
 // Test case function
 void run_kv_get_value_tests()
@@ -110,6 +138,37 @@ void run_kv_get_value_tests()
     assert(strcmp(buffer, "\"/home/\\\"user=data\"") == 0);
 #endif
 
+    // **Test 15: Long Lines And Long Keys**
+    {
+        static char input[8192];
+        char *pos = input;
+        for (int line = 0; line < 60; line++)
+        {
+            // Lines of varying length so line ends land on every block offset
+            pos += sprintf(pos, "a_rather_long_key_name_%02d_", line);
+            for (int pad = 0; pad < line; pad++)
+            {
+                *pos++ = 'x';
+            }
+            pos += sprintf(pos, "=value%d\n", line);
+        }
+        sprintf(pos, "a_rather_long_key_name_with_no_padding=tail");
+
+        memset(buffer, 0, sizeof(buffer));
+        buffer_count = kv_get_value(input, "a_rather_long_key_name_42_xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", buffer, sizeof(buffer));
+        assert(buffer_count == 7);
+        assert(strcmp(buffer, "value42") == 0);
+
+        memset(buffer, 0, sizeof(buffer));
+        buffer_count = kv_get_value(input, "a_rather_long_key_name_with_no_padding", buffer, sizeof(buffer));
+        assert(buffer_count == 4);
+        assert(strcmp(buffer, "tail") == 0);
+
+        memset(buffer, 0, sizeof(buffer));
+        buffer_count = kv_get_value(input, "a_rather_long_key_name_42_xxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxxx", buffer, sizeof(buffer));
+        assert(buffer_count == 0);
+    }
+
     printf("kv_get_value() passed successfully!\n");
 }
 
@@ -385,11 +444,1849 @@ void run_kv_file_get_value_tests()
     printf("kv_file_get_value() passed successfully!\n");
 }
 
+void run_kv_index_tests()
+{
+    kv_index_entry slots[16];
+    kv_index index;
+    char buffer[100] = {0};
+    int buffer_count = 0;
+
+    // **Test 1: Basic Key-Value Retrieval**
+    assert(kv_index_build(&index, "key1=value1\nkey2=value2", slots, 16) == 0);
+    assert(index.count == 2);
+    buffer_count = kv_index_get_value(&index, "key2", buffer, sizeof(buffer));
+    assert(buffer_count == 6);
+    assert(strcmp(buffer, "value2") == 0);
+
+    // **Test 2: Key Not Found**
+    buffer_count = kv_index_get_value(&index, "key3", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+    assert(kv_index_find(&index, "key") == NULL);
+
+    // **Test 3: Duplicate Keys (Return First Occurrence)**
+    assert(kv_index_build(&index, "x=1\nx=2\nx=3", slots, 16) == 0);
+    assert(index.count == 1);
+    buffer_count = kv_index_get_value(&index, "x", buffer, sizeof(buffer));
+    assert(buffer_count == 1);
+    assert(strcmp(buffer, "1") == 0);
+
+    // **Test 4: Buffer Too Small**
+    assert(kv_index_build(&index, "longkey=longvalue", slots, 16) == 0);
+    buffer_count = kv_index_get_value(&index, "longkey", buffer, 5);
+    assert(buffer_count == 0);
+    assert(buffer[0] == '\0');
+
+    // **Test 5: Table Too Small Or Not A Power Of Two**
+    assert(kv_index_build(&index, "a=1\nb=2\nc=3\nd=4", slots, 4) == -1);
+    assert(kv_index_build(&index, "a=1", slots, 12) == -1);
+
+    // **Test 6: Same Results As kv_get_value()**
+    const char *inputs[] = {
+        " key = value \n next = test ",
+        "a=one\r\nb=two",
+        "user-name=admin\nuser@domain.com=me",
+        "path=/home/user=data",
+        "path=\"/home/user=data\"",
+        "path=\"/home/user=data",
+        "path=\"/home/\\\"user=data\"",
+        "path=pre\"quoted\" tail",
+        "randomtext\nanotherline",
+    };
+    const char *keys[] = {"key", "next", "a", "b", "user-name", "path", "missing"};
+    for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+    {
+        assert(kv_index_build(&index, inputs[i], slots, 16) == 0);
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_value(inputs[i], keys[k], expected, sizeof(expected));
+            memset(buffer, 0, sizeof(buffer));
+            buffer_count = kv_index_get_value(&index, keys[k], buffer, sizeof(buffer));
+            assert(buffer_count == (int)expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+    }
+
+    printf("kv_index_get_value() passed successfully!\n");
+}
+
+void run_kv_get_values_tests()
+{
+    const char *input = " key = value \nx=1\nx=2\npath=\"/home/\\\"user=data\"\nlongkey=longvalue\r\nempty=";
+    const char *keys[] = {"x", "key", "path", "longkey", "missing", "empty"};
+    char bufs[6][100];
+    char *out_bufs[6] = {bufs[0], bufs[1], bufs[2], bufs[3], bufs[4], bufs[5]};
+    unsigned int out_max[6] = {100, 100, 100, 5, 100, 100};
+    unsigned int out_lens[6];
+
+    // **Test 1: String Batch Matches kv_get_value()**
+    {
+        kv_get_values(input, keys, 6, out_bufs, out_max, out_lens);
+        for (unsigned int k = 0; k < 6; k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_value(input, keys[k], expected, out_max[k]);
+            assert(out_lens[k] == expected_count);
+            assert(strcmp(bufs[k], expected) == 0);
+        }
+        assert(strcmp(bufs[0], "1") == 0);
+        assert(out_lens[3] == 0);
+        assert(out_lens[4] == 0);
+    }
+
+    // **Test 2: File Batch Matches String Batch**
+    {
+        char string_bufs[6][100];
+        unsigned int string_lens[6];
+        kv_get_values(input, keys, 6, out_bufs, out_max, out_lens);
+        memcpy(string_bufs, bufs, sizeof(bufs));
+        memcpy(string_lens, out_lens, sizeof(out_lens));
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs(input, temp);
+        unsigned int found = kv_file_get_values(temp, keys, 6, out_bufs, out_max, out_lens);
+        fclose(temp);
+
+        for (unsigned int k = 0; k < 6; k++)
+        {
+            assert(out_lens[k] == string_lens[k]);
+            assert(strcmp(bufs[k], string_bufs[k]) == 0);
+        }
+        assert(found == (out_lens[0] > 0) + (out_lens[1] > 0) + (out_lens[2] > 0));
+    }
+
+    // **Test 3: Trailing Whitespace After A Long Key**
+    {
+        const char *short_keys[] = {"ab"};
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs("abc=1\nab    =2", temp);
+        kv_file_get_values(temp, short_keys, 1, out_bufs, out_max, out_lens);
+        fclose(temp);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(out_lens[0] == 1);
+        assert(strcmp(bufs[0], "2") == 0);
+#else
+        assert(out_lens[0] == 0);
+#endif
+    }
+
+    // **Test 4: Keys Containing A Delimiter Match Like kv_get_value()**
+    {
+        const char *delim_input = "a=b=1\nc:d = 2\n";
+        const char *delim_keys[] = {"a", "a=b", "c", "c:d"};
+        kv_get_values(delim_input, delim_keys, 4, out_bufs, out_max, out_lens);
+        for (unsigned int k = 0; k < 4; k++)
+        {
+            char expected[100] = {0};
+            assert(out_lens[k] == kv_get_value(delim_input, delim_keys[k], expected, out_max[k]));
+            assert(strcmp(bufs[k], expected) == 0);
+        }
+        assert(strcmp(bufs[0], "b=1") == 0);
+        assert(strcmp(bufs[1], "1") == 0);
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs(delim_input, temp);
+        kv_file_get_values(temp, delim_keys, 4, out_bufs, out_max, out_lens);
+        fclose(temp);
+        assert(strcmp(bufs[0], "b=1") == 0);
+        assert(strcmp(bufs[1], "1") == 0);
+        assert(strcmp(bufs[2], "d = 2") == 0);
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+        assert(strcmp(bufs[3], "2") == 0);
+#else
+        assert(out_lens[3] == 0);
+#endif
+    }
+
+    // **Test 5: More Keys Than One Batch**
+    {
+        enum { many = 70 };
+        char many_input[many * 16];
+        char many_names[many][8];
+        char many_bufs[many][8];
+        const char *many_keys[many];
+        char *many_out[many];
+        unsigned int many_max[many];
+        unsigned int many_lens[many];
+        size_t used = 0;
+        for (unsigned int k = 0; k < many; k++)
+        {
+            snprintf(many_names[k], sizeof(many_names[k]), "k%u", k);
+            used += snprintf(many_input + used, sizeof(many_input) - used, "k%u=%u\n", many - 1 - k, many - 1 - k);
+            many_keys[k] = many_names[k];
+            many_out[k] = many_bufs[k];
+            many_max[k] = sizeof(many_bufs[k]);
+        }
+
+        kv_get_values(many_input, many_keys, many, many_out, many_max, many_lens);
+        for (unsigned int k = 0; k < many; k++)
+        {
+            char expected[8];
+            snprintf(expected, sizeof(expected), "%u", k);
+            assert(strcmp(many_bufs[k], expected) == 0);
+        }
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs(many_input, temp);
+        assert(kv_file_get_values(temp, many_keys, many, many_out, many_max, many_lens) == many);
+        fclose(temp);
+        for (unsigned int k = 0; k < many; k++)
+        {
+            char expected[8];
+            snprintf(expected, sizeof(expected), "%u", k);
+            assert(strcmp(many_bufs[k], expected) == 0);
+        }
+    }
+
+    // **Test 6: Values Longer Than The Line Buffer**
+    {
+        char long_input[KV_FILE_GET_VALUES_LINE_MAX * 2 + 16];
+        char long_value[KV_FILE_GET_VALUES_LINE_MAX * 2];
+        memset(long_value, 'v', sizeof(long_value) - 1);
+        long_value[sizeof(long_value) - 1] = '\0';
+        snprintf(long_input, sizeof(long_input), "long=%s\n", long_value);
+        const char *long_keys[] = {"long"};
+        char long_buf[sizeof(long_value)];
+        char *long_out[] = {long_buf};
+        unsigned int long_max[] = {sizeof(long_buf)};
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs(long_input, temp);
+        assert(kv_file_get_values(temp, long_keys, 1, long_out, long_max, out_lens) == 1);
+        fclose(temp);
+        assert(out_lens[0] == sizeof(long_value) - 1);
+        assert(strcmp(long_buf, long_value) == 0);
+    }
+
+    printf("kv_get_values() passed successfully!\n");
+}
+
+// Write a named file for the path based lookups
+void write_test_file(const char *path, const char *contents)
+{
+    FILE *file = fopen(path, "wb");
+    assert(file != NULL);
+    fputs(contents, file);
+    fclose(file);
+}
+
+void run_kv_mapped_file_tests()
+{
+    const char *path = "kv_mapped_file_test.tmp";
+    char buffer[100] = {0};
+    int buffer_count = 0;
+
+    // **Test 1: Last Key Without Trailing Newline**
+    write_test_file(path, "a=b\nc=d\ne=f\ng=hello");
+    buffer_count = kv_path_get_value(path, "g", buffer, sizeof(buffer));
+    assert(buffer_count == 5);
+    assert(strcmp(buffer, "hello") == 0);
+
+    // **Test 2: Key Not Found**
+    buffer_count = kv_path_get_value(path, "z", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    // **Test 3: Mapped Handle Matches kv_get_value()**
+    {
+        const char *input = " key = value \nx=1\nx=2\npath=\"/home/\\\"user=data\"\nlongkey=longvalue\r\nuncapped=\"tail   ";
+        const char *keys[] = {"key", "x", "path", "longkey", "uncapped", "missing"};
+        write_test_file(path, input);
+
+        kv_mapped_file mapped;
+        assert(kv_mapped_file_open(&mapped, path) == 0);
+        assert(mapped.size == strlen(input));
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_value(input, keys[k], expected, sizeof(expected));
+            buffer_count = kv_mapped_file_get_value(&mapped, keys[k], buffer, sizeof(buffer));
+            assert(buffer_count == (int)expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+        kv_mapped_file_close(&mapped);
+    }
+
+    // **Test 4: Empty File**
+    write_test_file(path, "");
+    buffer_count = kv_path_get_value(path, "anykey", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    // **Test 5: Missing File**
+    remove(path);
+    buffer_count = kv_path_get_value(path, "anykey", buffer, sizeof(buffer));
+    assert(buffer_count == 0);
+
+    printf("kv_path_get_value() passed successfully!\n");
+}
+
+void run_kv_get_value_view_tests()
+{
+    char buffer[100] = {0};
+    kv_value_view view;
+
+    // **Test 1: Basic Key-Value Retrieval**
+    view = kv_get_value_view("key1=value1\nkey2=value2", "key2");
+    assert(view.ptr != NULL);
+    assert(view.len == 6);
+    assert(memcmp(view.ptr, "value2", 6) == 0);
+
+    // **Test 2: Key Not Found Versus Empty Value**
+    view = kv_get_value_view("a=b\nc=d", "z");
+    assert(view.ptr == NULL);
+    view = kv_get_value_view("a=\nc=d", "a");
+    assert(view.ptr != NULL);
+    assert(view.len == 0);
+
+    // **Test 3: Duplicate Keys (Return First Occurrence)**
+    view = kv_get_value_view("x=1\nx=2\nx=3", "x");
+    assert(view.len == 1);
+    assert(view.ptr[0] == '1');
+
+    // **Test 4: Quoted String **
+    view = kv_get_value_view("path=\"/home/user=data\"", "path");
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(view.flags == KV_VALUE_QUOTED);
+    assert(view.len == 15);
+    assert(memcmp(view.ptr, "/home/user=data", 15) == 0);
+#else
+    assert(view.flags == 0);
+    assert(view.len == 17);
+#endif
+
+    // **Test 5: Quoted String With Escaped Quote Needs Copy**
+    view = kv_get_value_view("path=\"/home/\\\"user=data\"", "path");
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    assert(view.flags == (KV_VALUE_QUOTED | KV_VALUE_ESCAPED));
+#else
+    assert(view.flags == 0);
+#endif
+    assert(kv_value_view_copy(view, buffer, view.len + 1) == kv_get_value("path=\"/home/\\\"user=data\"", "path", buffer + 50, 50));
+    assert(strcmp(buffer, buffer + 50) == 0);
+
+    // **Test 6: Buffer Too Small**
+    view = kv_get_value_view("longkey=longvalue", "longkey");
+    assert(view.len == 9);
+    assert(kv_value_view_copy(view, buffer, 5) == 0);
+    assert(kv_value_view_copy(view, buffer, 10) == 9);
+    assert(strcmp(buffer, "longvalue") == 0);
+
+    printf("kv_get_value_view() passed successfully!\n");
+}
+
+// Collects the first reported value, stopping the stream
+int kv_stream_test_first(void *ctx, const kv_pair *pair)
+{
+    strcpy((char *)ctx, pair->value);
+    return 1;
+}
+
+// Counts every reported pair
+int kv_stream_test_count(void *ctx, const kv_pair *pair)
+{
+    (void)pair;
+    (*(int *)ctx)++;
+    return 0;
+}
+
+void run_kv_stream_tests()
+{
+    const char *input = " key = value \nx=1\nx=2\npath=\"/home/\\\"user=data\"\nlongkey=longvalue\r\nnodelimiter\nuncapped=\"tail   ";
+    const char *keys[] = {"key", "x", "path", "longkey", "uncapped", "missing"};
+    char key_buf[16];
+    char value_buf[100];
+    kv_stream stream;
+
+    // **Test 1: Any Chunk Size Matches kv_get_value()**
+    for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+    {
+        char expected[100] = {0};
+        kv_get_value(input, keys[k], expected, sizeof(expected));
+
+        for (size_t chunk = 1; chunk <= strlen(input); chunk++)
+        {
+            char found[100] = {0};
+            kv_stream_init(&stream, keys[k], key_buf, sizeof(key_buf), value_buf, sizeof(value_buf), kv_stream_test_first, found);
+            for (size_t pos = 0; pos < strlen(input); pos += chunk)
+            {
+                size_t len = strlen(input) - pos < chunk ? strlen(input) - pos : chunk;
+                if (kv_stream_feed(&stream, input + pos, len))
+                {
+                    break;
+                }
+            }
+            kv_stream_finish(&stream);
+            assert(strcmp(found, expected) == 0);
+        }
+    }
+
+    // **Test 2: Every Pair Reported**
+    {
+        int count = 0;
+        kv_stream_init(&stream, NULL, key_buf, sizeof(key_buf), value_buf, sizeof(value_buf), kv_stream_test_count, &count);
+        assert(kv_stream_feed(&stream, input, strlen(input)) == 0);
+        assert(kv_stream_finish(&stream) == 0);
+        assert(count == 6);
+    }
+
+    // **Test 3: Oversized Key And Value Are Dropped**
+    {
+        int count = 0;
+        char small_value[5];
+        kv_stream_init(&stream, NULL, key_buf, sizeof(key_buf), small_value, sizeof(small_value), kv_stream_test_count, &count);
+        kv_stream_feed(&stream, "a_key_longer_than_sixteen=1\nlongkey=longvalue\nok=1", 50);
+        kv_stream_finish(&stream);
+        assert(count == 1);
+        assert(stream.dropped == 2);
+    }
+
+    printf("kv_stream_feed() passed successfully!\n");
+}
+
+// Appends "key=value;" for each pair, stopping after `limit` pairs
+typedef struct
+{
+    char out[200];
+    int count;
+    int limit;
+} kv_foreach_test_ctx;
+
+int kv_foreach_test_collect(void *ctx, const kv_pair *pair)
+{
+    kv_foreach_test_ctx *test = ctx;
+    char value[100];
+    kv_scan_unescape(pair->value, pair->value_len, pair->flags, value, sizeof(value));
+    sprintf(test->out + strlen(test->out), "%.*s=%s;", (int)pair->key_len, pair->key, value);
+    return ++test->count == test->limit;
+}
+
+void run_kv_foreach_tests()
+{
+    const char *input = "a=b\nrandomtext\nx=1\nx=2\npath=\"/home/\\\"user=data\"\r\nlast=one";
+
+    // **Test 1: Every Pair In Order**
+    {
+        kv_foreach_test_ctx test = {{0}, 0, 0};
+        assert(kv_foreach(input, kv_foreach_test_collect, &test) == 0);
+        assert(test.count == 5);
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+        assert(strcmp(test.out, "a=b;x=1;x=2;path=/home/\"user=data;last=one;") == 0);
+#else
+        assert(strcmp(test.out, "a=b;x=1;x=2;path=\"/home/\\\"user=data\";last=one;") == 0);
+#endif
+    }
+
+    // **Test 2: File Walk Matches String Walk**
+    {
+        kv_foreach_test_ctx expected = {{0}, 0, 0};
+        kv_foreach_test_ctx test = {{0}, 0, 0};
+        kv_foreach(input, kv_foreach_test_collect, &expected);
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs(input, temp);
+        assert(kv_file_foreach(temp, kv_foreach_test_collect, &test) == 0);
+        fclose(temp);
+
+        assert(test.count == expected.count);
+        assert(strcmp(test.out, expected.out) == 0);
+    }
+
+    // **Test 3: Callback Stops Early**
+    {
+        kv_foreach_test_ctx test = {{0}, 0, 2};
+        assert(kv_foreach(input, kv_foreach_test_collect, &test) == 1);
+        assert(strcmp(test.out, "a=b;x=1;") == 0);
+
+        FILE *temp = tmpfile();
+        assert(temp != NULL);
+        fputs(input, temp);
+        test.out[0] = '\0';
+        test.count = 0;
+        assert(kv_file_foreach(temp, kv_foreach_test_collect, &test) == 1);
+        fclose(temp);
+        assert(strcmp(test.out, "a=b;x=1;") == 0);
+    }
+
+    printf("kv_foreach() passed successfully!\n");
+}
+
+void run_kv_file_cache_tests()
+{
+    const char *path = "kv_file_cache_test.tmp";
+    const unsigned int modes[] = {0, KV_FILE_CACHE_INOTIFY};
+
+    for (int m = 0; m < 2; m++)
+    {
+        kv_file_cache cache;
+        char buffer[100] = {0};
+        int buffer_count = 0;
+        assert(kv_file_cache_init(&cache, modes[m]) == 0);
+
+        // **Test 1: First Lookup Reads The File**
+        write_test_file(path, "mode=fast\nlevel=1");
+        buffer_count = kv_file_cache_get_value(&cache, path, "mode", buffer, sizeof(buffer));
+        assert(buffer_count == 4);
+        assert(strcmp(buffer, "fast") == 0);
+
+        // **Test 2: Unchanged File Is Not Reread**
+        const char *data = cache.entries[0].data;
+        buffer_count = kv_file_cache_get_value(&cache, path, "level", buffer, sizeof(buffer));
+        assert(buffer_count == 1);
+        assert(cache.entries[0].data == data);
+
+        // **Test 3: Changed File Is Reread**
+        write_test_file(path, "mode=careful\nlevel=2");
+        buffer_count = kv_file_cache_get_value(&cache, path, "mode", buffer, sizeof(buffer));
+        assert(buffer_count == 7);
+        assert(strcmp(buffer, "careful") == 0);
+
+        // **Test 4: Missing File**
+        remove(path);
+        buffer_count = kv_file_cache_get_value(&cache, path, "mode", buffer, sizeof(buffer));
+        assert(buffer_count == 0);
+        assert(kv_file_cache_get(&cache, "kv_file_cache_missing.tmp") == NULL);
+
+        kv_file_cache_free(&cache);
+    }
+
+    printf("kv_file_cache_get_value() passed successfully!\n");
+}
+
+// Reads two keys from the same snapshot while the writer keeps publishing
+void *kv_snapshot_test_reader(void *arg)
+{
+    kv_snapshot_store *store = arg;
+    int reader = kv_snapshot_store_register(store);
+    assert(reader >= 0);
+
+    for (int i = 0; i < 20000; i++)
+    {
+        char version[32];
+        char check[32];
+        const kv_index *index = kv_snapshot_read_begin(store, reader);
+        assert(index != NULL);
+        assert(kv_index_get_value(index, "version", version, sizeof(version)) > 0);
+        assert(kv_index_get_value(index, "check", check, sizeof(check)) > 0);
+        kv_snapshot_read_end(store, reader);
+        assert(strcmp(version, check) == 0);
+    }
+
+    kv_snapshot_store_unregister(store, reader);
+    return NULL;
+}
+
+void run_kv_snapshot_tests()
+{
+    static kv_snapshot_store store;
+    char buffer[100] = {0};
+    char text[64];
+
+    assert(kv_snapshot_store_init(&store) == 0);
+
+    // **Test 1: Nothing Published Yet**
+    int reader = kv_snapshot_store_register(&store);
+    assert(reader >= 0);
+    assert(kv_snapshot_store_get_value(&store, reader, "version", buffer, sizeof(buffer)) == 0);
+
+    // **Test 2: Published Snapshot Is Visible**
+    assert(kv_snapshot_store_publish(&store, "version=0\ncheck=0", 17) == 0);
+    assert(kv_snapshot_store_get_value(&store, reader, "version", buffer, sizeof(buffer)) == 1);
+    assert(strcmp(buffer, "0") == 0);
+
+    // **Test 3: Held Snapshot Survives A Publish**
+    const kv_index *held = kv_snapshot_read_begin(&store, reader);
+    assert(kv_snapshot_store_publish(&store, "version=1\ncheck=1", 17) == 0);
+    assert(store.retired != NULL);
+    assert(kv_index_get_value(held, "version", buffer, sizeof(buffer)) == 1);
+    assert(strcmp(buffer, "0") == 0);
+    kv_snapshot_read_end(&store, reader);
+    kv_snapshot_store_reclaim(&store);
+    assert(store.retired == NULL);
+    kv_snapshot_store_unregister(&store, reader);
+
+    // **Test 4: Concurrent Readers See Consistent Snapshots**
+    pthread_t threads[4];
+    for (int t = 0; t < 4; t++)
+    {
+        assert(pthread_create(&threads[t], NULL, kv_snapshot_test_reader, &store) == 0);
+    }
+    for (int v = 2; v < 500; v++)
+    {
+        int len = sprintf(text, "version=%d\ncheck=%d", v, v);
+        assert(kv_snapshot_store_publish(&store, text, len) == 0);
+    }
+    for (int t = 0; t < 4; t++)
+    {
+        pthread_join(threads[t], NULL);
+    }
+    kv_snapshot_store_reclaim(&store);
+    assert(store.retired == NULL);
+
+    kv_snapshot_store_free(&store);
+
+    printf("kv_snapshot_store_get_value() passed successfully!\n");
+}
+
+void run_kv_index_parallel_tests()
+{
+    static char input[16384];
+    static kv_index_entry slots[2048];
+    static kv_index_entry expected_slots[2048];
+    kv_index index;
+    kv_index expected;
+
+    // Keys repeat every 97 lines so duplicates land in different chunks
+    char *pos = input;
+    for (int line = 0; line < 400; line++)
+    {
+        pos += sprintf(pos, line % 13 == 0 ? "comment line %d\n" : " key%d = \"value %d\"\n", line % 97, line);
+    }
+    assert(kv_index_build(&expected, input, expected_slots, 2048) == 0);
+
+    // **Test 1: Any Thread Count Matches kv_index_build(), Whichever Thread Wins Each Slot**
+    for (unsigned int round = 0; round < 20 * 9; round++)
+    {
+        const unsigned int threads = 1 + round % 9;
+        assert(kv_index_build_parallel(&index, input, strlen(input), slots, 2048, threads) == 0);
+        assert(index.count == expected.count);
+        for (int k = 0; k < 100; k++)
+        {
+            char key[16];
+            char value[32] = {0};
+            char expected_value[32] = {0};
+            sprintf(key, "key%d", k);
+            unsigned int expected_count = kv_index_get_value(&expected, key, expected_value, sizeof(expected_value));
+            assert(kv_index_get_value(&index, key, value, sizeof(value)) == expected_count);
+            assert(strcmp(value, expected_value) == 0);
+        }
+    }
+
+    // **Test 2: Table Too Small**
+    assert(kv_index_build_parallel(&index, input, strlen(input), slots, 64, 4) == -1);
+
+    printf("kv_index_build_parallel() passed successfully!\n");
+}
+
+void run_kv_compiled_tests()
+{
+    const char *text_path = "kv_compiled_test.tmp";
+    const char *image_path = "kv_compiled_test.kvc.tmp";
+    const char *input = " key = value \nx=1\nx=2\npath=\"/home/\\\"user=data\"\nlongkey=longvalue\r\nempty=\nuncapped=\"tail   ";
+    const char *keys[] = {"key", "x", "path", "longkey", "empty", "uncapped", "missing"};
+    char buffer[100] = {0};
+    kv_compiled compiled;
+
+    write_test_file(text_path, input);
+    assert(kv_compile_path(text_path, image_path) == 0);
+
+    // **Test 1: Image Lookups Match kv_get_value()**
+    assert(kv_compiled_open(&compiled, image_path, text_path) == 0);
+    for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+    {
+        char expected[100] = {0};
+        unsigned int expected_count = kv_get_value(input, keys[k], expected, sizeof(expected));
+        assert(kv_compiled_get_value(&compiled, keys[k], buffer, sizeof(buffer)) == expected_count);
+        assert(strcmp(buffer, expected) == 0);
+    }
+
+    // **Test 2: Zero-Copy Find**
+    {
+        size_t len = 0;
+        assert(kv_compiled_find(&compiled, "x", &len) != NULL);
+        assert(len == 1);
+        assert(strcmp(kv_compiled_find(&compiled, "x", NULL), "1") == 0);
+        assert(kv_compiled_find(&compiled, "missing", NULL) == NULL);
+        assert(kv_compiled_get_value(&compiled, "longkey", buffer, 5) == 0);
+    }
+    kv_compiled_close(&compiled);
+
+    // **Test 3: Corrupted Image Falls Back To Text**
+    {
+        FILE *image = fopen(image_path, "r+b");
+        assert(image != NULL);
+        fseek(image, -3, SEEK_END);
+        fputc('#', image);
+        fclose(image);
+
+        assert(kv_compiled_open(&compiled, image_path, text_path) == 1);
+        assert(kv_compiled_get_value(&compiled, "x", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+        kv_compiled_close(&compiled);
+    }
+
+    // **Test 4: Stale Image Falls Back To Text**
+    {
+        assert(kv_compile_path(text_path, image_path) == 0);
+        write_test_file(text_path, "x=changed");
+        assert(kv_compiled_open(&compiled, image_path, text_path) == 1);
+        assert(kv_compiled_get_value(&compiled, "x", buffer, sizeof(buffer)) == 7);
+        assert(strcmp(buffer, "changed") == 0);
+        kv_compiled_close(&compiled);
+    }
+
+    // **Test 5: Same Size Edit Within One Second Falls Back To Text**
+    {
+        struct timespec times[2] = {{1700000000, 100}, {1700000000, 100}};
+        write_test_file(text_path, "x=1");
+        assert(utimensat(AT_FDCWD, text_path, times, 0) == 0);
+        assert(kv_compile_path(text_path, image_path) == 0);
+        assert(kv_compiled_open(&compiled, image_path, text_path) == 0);
+        kv_compiled_close(&compiled);
+
+        write_test_file(text_path, "x=2");
+        times[0].tv_nsec = times[1].tv_nsec = 200;
+        assert(utimensat(AT_FDCWD, text_path, times, 0) == 0);
+        assert(kv_compiled_open(&compiled, image_path, text_path) == 1);
+        assert(kv_compiled_get_value(&compiled, "x", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "2") == 0);
+        kv_compiled_close(&compiled);
+    }
+
+    // **Test 6: Crafted Images With Valid Checksums Are Rejected**
+    for (int craft = 0; craft < 2; craft++)
+    {
+        write_test_file(text_path, input);
+        assert(kv_compile_path(text_path, image_path) == 0);
+
+        static unsigned char image[4096];
+        FILE *file = fopen(image_path, "rb");
+        assert(file != NULL);
+        const size_t size = fread(image, 1, sizeof(image), file);
+        fclose(file);
+        assert(size > sizeof(kv_compiled_header) && size < sizeof(image));
+
+        kv_compiled_header *header = (kv_compiled_header *)image;
+        kv_compiled_slot *slots = (kv_compiled_slot *)(image + sizeof(kv_compiled_header));
+        uint32_t used = 0;
+        while (slots[used].key_offset == 0)
+        {
+            used++;
+        }
+        if (craft == 0)
+        {
+            /* Value past the end of the image */
+            slots[used].value_offset = (uint32_t)size;
+        }
+        else
+        {
+            /* Every slot full, so a missing key would probe forever */
+            for (uint32_t i = 0; i < header->slot_count; i++)
+            {
+                slots[i] = slots[used];
+            }
+            header->count = header->slot_count;
+        }
+
+        uint64_t checksum = 14695981039346656037u;
+        for (size_t i = sizeof(kv_compiled_header); i < size; i++)
+        {
+            checksum = (checksum ^ image[i]) * 1099511628211u;
+        }
+        header->checksum = checksum;
+        file = fopen(image_path, "wb");
+        assert(file != NULL);
+        assert(fwrite(image, 1, size, file) == size);
+        fclose(file);
+
+        assert(kv_compiled_open(&compiled, image_path, NULL) == -1);
+        assert(kv_compiled_open(&compiled, image_path, text_path) == 1);
+        assert(kv_compiled_get_value(&compiled, "missing", buffer, sizeof(buffer)) == 0);
+        kv_compiled_close(&compiled);
+    }
+
+    // **Test 6: Missing Image And Text**
+    remove(image_path);
+    remove(text_path);
+    assert(kv_compiled_open(&compiled, image_path, text_path) == -1);
+
+    printf("kv_compiled_get_value() passed successfully!\n");
+}
+
+void run_kv_store_tests()
+{
+    const char *path = "kv_store_test.tmp";
+    const char *input = " key = value \nx=1\nx=2\npath=\"/home/\\\"user=data\"\nlongkey=longvalue\r\nempty=\nuncapped=\"tail   ";
+    const char *keys[] = {"key", "x", "path", "longkey", "empty", "uncapped", "missing"};
+    kv_store store;
+
+    // **Test 1: String Store Matches kv_get_value()**
+    {
+        char source[200];
+        strcpy(source, input);
+        assert(kv_store_load(&store, source) == 0);
+        memset(source, '#', strlen(source));
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_value(input, keys[k], expected, sizeof(expected));
+            size_t len = 0;
+            const char *value = kv_store_get(&store, keys[k], &len);
+            assert(value ? len == expected_count : expected_count == 0);
+            assert(value == NULL || strcmp(value, expected) == 0);
+        }
+        assert(kv_store_get(&store, "missing", NULL) == NULL);
+        assert(store.count == 6);
+    }
+
+    // **Test 2: Interned Keys**
+    {
+        const char *key = kv_store_intern(&store, "x");
+        assert(key != NULL);
+        assert(strcmp(key, "x") == 0);
+        assert(kv_store_intern(&store, "x") == key);
+        assert(kv_store_intern(&store, "missing") == NULL);
+    }
+    kv_store_free(&store);
+    assert(kv_store_get(&store, "x", NULL) == NULL);
+
+    // **Test 3: File Store Matches kv_file_get_value()**
+    {
+        write_test_file(path, input);
+        FILE *file = fopen(path, "r");
+        assert(file != NULL);
+        assert(kv_store_load_file(&store, file) == 0);
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_file_get_value(file, keys[k], expected, sizeof(expected));
+            const char *value = kv_store_get(&store, keys[k], NULL);
+            assert(value ? strlen(value) == expected_count : expected_count == 0);
+            assert(value == NULL || strcmp(value, expected) == 0);
+        }
+        fclose(file);
+        remove(path);
+        kv_store_free(&store);
+    }
+
+    // **Test 3b: File Larger Than One Read Block**
+    {
+        static char large[20000];
+        size_t len = 0;
+        for (unsigned int i = 0; len + 32 < sizeof(large); i++)
+        {
+            len += sprintf(large + len, "key%u=value%u\n", i, i);
+        }
+        write_test_file(path, large);
+        FILE *file = fopen(path, "r");
+        assert(file != NULL);
+        assert(kv_store_load_file(&store, file) == 0);
+        fclose(file);
+        remove(path);
+
+        kv_store from_string;
+        assert(kv_store_load(&from_string, large) == 0);
+        assert(store.count == from_string.count && store.count > 1000);
+        assert(strcmp(kv_store_get(&store, "key1000", NULL), "value1000") == 0);
+        kv_store_free(&from_string);
+        kv_store_free(&store);
+    }
+
+    // **Test 4: Empty Input**
+    assert(kv_store_load(&store, "") == 0);
+    assert(store.count == 0);
+    assert(kv_store_get(&store, "x", NULL) == NULL);
+    kv_store_free(&store);
+
+    printf("kv_store_get() passed successfully!\n");
+}
+
+void run_kv_get_typed_tests()
+{
+    const char *path = "kv_get_typed_test.tmp";
+    const char *input = "port=443\nneg:-9223372036854775808\nbig=9223372036854775808\nhex=0xff\nquoted=\"42\"\nratio=2.5\nhuge=1e999\n"
+                        "bad=12abc\nempty=\nflag=Yes\nflag=no\noff=0\numax=18446744073709551615\nuover=18446744073709551616\n";
+    int64_t i64 = 0;
+    uint64_t u64 = 0;
+    double d = 0;
+    int b = 0;
+
+    // **Test 1: Integers**
+    assert(kv_get_int64(input, "port", &i64) == KV_TYPED_OK && i64 == 443);
+    assert(kv_get_int64(input, "neg", &i64) == KV_TYPED_OK && i64 == INT64_MIN);
+    assert(kv_get_int64(input, "hex", &i64) == KV_TYPED_OK && i64 == 255);
+    assert(kv_get_uint64(input, "umax", &u64) == KV_TYPED_OK && u64 == UINT64_MAX);
+    assert(kv_get_uint64(input, "neg", &u64) == KV_TYPED_INVALID);
+
+    // **Test 2: Overflow, Not Found And Invalid Are Reported Separately**
+    i64 = 7;
+    assert(kv_get_int64(input, "big", &i64) == KV_TYPED_OVERFLOW);
+    assert(kv_get_uint64(input, "uover", &u64) == KV_TYPED_OVERFLOW);
+    assert(kv_get_int64(input, "missing", &i64) == KV_TYPED_NOT_FOUND);
+    assert(kv_get_int64(input, "bad", &i64) == KV_TYPED_INVALID);
+    assert(kv_get_int64(input, "empty", &i64) == KV_TYPED_INVALID);
+    assert(i64 == 7);
+
+    // **Test 3: Doubles And Booleans**
+    assert(kv_get_double(input, "ratio", &d) == KV_TYPED_OK && d == 2.5);
+    assert(kv_get_double(input, "huge", &d) == KV_TYPED_OVERFLOW);
+    assert(kv_get_double(input, "bad", &d) == KV_TYPED_INVALID);
+    assert(kv_get_bool(input, "flag", &b) == KV_TYPED_OK && b == 1);
+    assert(kv_get_bool(input, "off", &b) == KV_TYPED_OK && b == 0);
+    assert(kv_get_bool(input, "port", &b) == KV_TYPED_INVALID);
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    // **Test 4: Quoted Numbers**
+    assert(kv_get_int64(input, "quoted", &i64) == KV_TYPED_OK && i64 == 42);
+    assert(kv_get_int64("x=\"-\\\"1\"", "x", &i64) == KV_TYPED_INVALID);
+#endif
+
+    // **Test 5: File Counterparts Match**
+    {
+        write_test_file(path, input);
+        FILE *file = fopen(path, "r");
+        assert(file != NULL);
+        const char *keys[] = {"port", "neg", "big", "hex", "quoted", "ratio", "huge", "bad", "empty", "flag", "off", "umax", "uover", "missing"};
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            int64_t file_i64 = 0;
+            uint64_t file_u64 = 0;
+            double file_d = 0;
+            int file_b = 0;
+            i64 = 0;
+            u64 = 0;
+            d = 0;
+            b = 0;
+            assert(kv_file_get_int64(file, keys[k], &file_i64) == kv_get_int64(input, keys[k], &i64) && file_i64 == i64);
+            assert(kv_file_get_uint64(file, keys[k], &file_u64) == kv_get_uint64(input, keys[k], &u64) && file_u64 == u64);
+            assert(kv_file_get_double(file, keys[k], &file_d) == kv_get_double(input, keys[k], &d) && file_d == d);
+            assert(kv_file_get_bool(file, keys[k], &file_b) == kv_get_bool(input, keys[k], &b) && file_b == b);
+        }
+        fclose(file);
+        remove(path);
+    }
+
+    printf("kv_get_int64() passed successfully!\n");
+}
+
+void run_kv_section_tests()
+{
+    const char *input = "name=global\n[server]\nport=80\nhost=example.com\n[client]\nport=8080\n[ spaced ]\nkey = value\n[server]\nport=81\ntimeout=5\n[broken\nbroken=1";
+    char buffer[100] = {0};
+    kv_section_entry sections[8];
+    kv_section_table table;
+
+    // **Test 1: Section Lookups**
+    assert(kv_get_section_value(input, "server", "port", buffer, sizeof(buffer)) == 2);
+    assert(strcmp(buffer, "80") == 0);
+    assert(kv_get_section_value(input, "client", "port", buffer, sizeof(buffer)) == 4);
+    assert(strcmp(buffer, "8080") == 0);
+    assert(kv_get_section_value(input, NULL, "name", buffer, sizeof(buffer)) == 6);
+    assert(strcmp(buffer, "global") == 0);
+    assert(kv_get_section_value(input, "client", "host", buffer, sizeof(buffer)) == 0);
+    assert(kv_get_section_value(input, "missing", "port", buffer, sizeof(buffer)) == 0);
+
+    // **Test 2: Repeated Sections Are Searched In Order**
+    assert(kv_get_section_value(input, "server", "timeout", buffer, sizeof(buffer)) == 1);
+    assert(strcmp(buffer, "5") == 0);
+
+    // **Test 3: Unterminated Header Is An Ordinary Line**
+    assert(kv_get_section_value(input, "server", "broken", buffer, sizeof(buffer)) == 1);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    // **Test 4: Whitespace Around Section Names**
+    assert(kv_get_section_value(input, "spaced", "key", buffer, sizeof(buffer)) == 5);
+    assert(strcmp(buffer, "value") == 0);
+#endif
+
+    // **Test 5: Section Table Matches kv_get_section_value()**
+    assert(kv_section_count(input) == 5);
+    assert(kv_section_table_build(&table, input, sections, 4) == -1);
+    assert(kv_section_table_build(&table, input, sections, 8) == 0);
+    assert(table.count == 5);
+    {
+        const char *pairs[][2] = {{"server", "port"}, {"client", "port"}, {NULL, "name"}, {"", "name"}, {"client", "host"}, {"server", "timeout"}, {"server", "broken"}, {"spaced", "key"}, {"missing", "port"}};
+        for (size_t k = 0; k < sizeof(pairs) / sizeof(pairs[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_section_value(input, pairs[k][0], pairs[k][1], expected, sizeof(expected));
+            assert(kv_section_table_get_value(&table, pairs[k][0], pairs[k][1], buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+    }
+
+    // **Test 6: Keys Containing Delimiters Match Like kv_get_value()**
+    {
+        const char *urls = "[proxy]\nhttp://host=direct\nhttp=plain";
+        const char *section_keys[] = {"http", "http://host", "http:"};
+        assert(kv_section_table_build(&table, urls, sections, 8) == 0);
+        for (size_t k = 0; k < sizeof(section_keys) / sizeof(section_keys[0]); k++)
+        {
+            char expected[100] = {0};
+            const unsigned int expected_count = kv_get_value(urls + strlen("[proxy]\n"), section_keys[k], expected, sizeof(expected));
+            assert(kv_get_section_value(urls, "proxy", section_keys[k], buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+            assert(kv_section_table_get_value(&table, "proxy", section_keys[k], buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+    }
+
+    printf("kv_get_section_value() passed successfully!\n");
+}
+
+static void *kv_stats_thread(void *arg)
+{
+    char buffer[100];
+    kv_stats stats;
+    kv_stats_reset();
+    kv_get_value((const char *)arg, "missing", buffer, sizeof(buffer));
+    kv_stats_snapshot(&stats);
+#ifdef KV_PARSE_STATS
+    assert(stats.misses == 1);
+#else
+    assert(stats.misses == 0);
+#endif
+    return NULL;
+}
+
+void run_kv_stats_tests()
+{
+    const char *path = "kv_stats_test.tmp";
+    const char *input = "alpha=1\nalps=2\nbeta=3\nkey=toolongvalue";
+    char buffer[100] = {0};
+    kv_stats stats;
+
+    // **Test 1: Hit After Skipped Lines**
+    kv_stats_reset();
+    assert(kv_get_value(input, "beta", buffer, sizeof(buffer)) == 1);
+    kv_stats_snapshot(&stats);
+#ifdef KV_PARSE_STATS
+    assert(stats.hits == 1 && stats.misses == 0 && stats.truncated == 0);
+    assert(stats.lines_skipped == 2 && stats.partial_matches == 0);
+    assert(stats.bytes_scanned == strlen("alpha=1\nalps=2\nbeta=3"));
+#else
+    assert(stats.hits == 0 && stats.bytes_scanned == 0);
+#endif
+
+    // **Test 2: Partial Matches, Truncation And Misses Accumulate**
+    assert(kv_get_value(input, "alps", buffer, sizeof(buffer)) == 1);
+    assert(kv_get_value(input, "key", buffer, 5) == 0);
+    assert(kv_get_value(input, "missing", buffer, sizeof(buffer)) == 0);
+    kv_stats_snapshot(&stats);
+#ifdef KV_PARSE_STATS
+    assert(stats.hits == 2 && stats.truncated == 1 && stats.misses == 1);
+    assert(stats.lines_skipped == 2 + 1 + 3 + 4);
+    assert(stats.partial_matches == 1);
+#endif
+
+    // **Test 3: File Lookups Count The Same Events**
+    {
+        write_test_file(path, input);
+        FILE *file = fopen(path, "r");
+        assert(file != NULL);
+        kv_stats_reset();
+        assert(kv_file_get_value(file, "beta", buffer, sizeof(buffer)) == 1);
+        assert(kv_file_get_value(file, "alps", buffer, sizeof(buffer)) == 1);
+        assert(kv_file_get_value(file, "missing", buffer, sizeof(buffer)) == 0);
+        kv_stats_snapshot(&stats);
+#ifdef KV_PARSE_STATS
+        assert(stats.hits == 2 && stats.misses == 1);
+        assert(stats.lines_skipped == 2 + 1 + 4);
+        assert(stats.partial_matches == 1);
+        assert(stats.bytes_scanned >= strlen(input));
+#endif
+        fclose(file);
+        remove(path);
+    }
+
+    // **Test 4: Counters Are Per Thread**
+    {
+        kv_stats before;
+        pthread_t thread;
+        kv_stats_snapshot(&before);
+        assert(pthread_create(&thread, NULL, kv_stats_thread, (void *)input) == 0);
+        pthread_join(thread, NULL);
+        kv_stats_snapshot(&stats);
+        assert(stats.misses == before.misses);
+    }
+
+    // **Test 5: Reset**
+    kv_stats_reset();
+    kv_stats_snapshot(&stats);
+    assert(stats.hits == 0 && stats.lines_skipped == 0 && stats.bytes_scanned == 0);
+
+    printf("kv_stats_snapshot() passed successfully!\n");
+}
+
+void run_kv_sorted_tests()
+{
+    const char *path = "kv_sorted_test.tmp";
+    static char input[64 * 1024];
+    char buffer[100] = {0};
+
+    // **Test 1: Small Sorted Input With Blank Lines And Duplicates**
+    {
+        const char *small = "\nalpha=1\nbeta=2\nbeta=duplicate\n\n\ngamma=3\nnot a pair\nzeta=\"quoted\"";
+        const char *keys[] = {"alpha", "beta", "gamma", "zeta", "aaa", "delta", "zzz", "bet", "betaa"};
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_value(small, keys[k], expected, sizeof(expected));
+            assert(kv_sorted_get_value(small, strlen(small), keys[k], buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+        assert(kv_sorted_get_value("", 0, "alpha", buffer, sizeof(buffer)) == 0);
+        assert(kv_sorted_get_value("alpha=1\nbeta=2", 7, "beta", buffer, sizeof(buffer)) == 0);
+    }
+
+    // **Test 2: Large Sorted Input Matches kv_get_value()**
+    {
+        size_t len = 0;
+        for (int i = 0; i < 2000; i += 2)
+        {
+            len += sprintf(input + len, "key%04d=value%d\n%s", i, i, (i % 7 == 0) ? "\n" : "");
+        }
+
+        for (int i = 0; i < 2001; i++)
+        {
+            char key[16];
+            char expected[100] = {0};
+            sprintf(key, "key%04d", i);
+            unsigned int expected_count = kv_get_value(input, key, expected, sizeof(expected));
+            assert(kv_sorted_get_value(input, len, key, buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+    }
+
+    // **Test 3: Seekable File Matches The Buffer Search**
+    {
+        write_test_file(path, input);
+        FILE *file = fopen(path, "r");
+        assert(file != NULL);
+        for (int i = 0; i < 2001; i += 3)
+        {
+            char key[16];
+            char expected[100] = {0};
+            sprintf(key, "key%04d", i);
+            unsigned int expected_count = kv_sorted_get_value(input, strlen(input), key, expected, sizeof(expected));
+            assert(kv_file_sorted_get_value(file, key, buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+        fclose(file);
+    }
+
+    // **Test 4: File Lines Longer Than The Window**
+    {
+        size_t len = sprintf(input, "a=1\nlong=");
+        memset(input + len, 'x', KV_SORTED_FILE_WINDOW * 2);
+        len += KV_SORTED_FILE_WINDOW * 2;
+        sprintf(input + len, "\nm=2\nz=3\n");
+        write_test_file(path, input);
+        FILE *file = fopen(path, "r");
+        assert(file != NULL);
+        assert(kv_file_sorted_get_value(file, "a", buffer, sizeof(buffer)) == 1);
+        assert(kv_file_sorted_get_value(file, "m", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "2") == 0);
+        assert(kv_file_sorted_get_value(file, "z", buffer, sizeof(buffer)) == 1);
+        assert(kv_file_sorted_get_value(file, "long", buffer, sizeof(buffer)) == 0);
+        fclose(file);
+        remove(path);
+    }
+
+    printf("kv_sorted_get_value() passed successfully!\n");
+}
+
+void run_kv_keys_tests()
+{
+    const char *input = "XDG_SESSION_TYPE=x11\nHOME=/home/user\nXDG_CURRENT_DESKTOP=GNOME\nfeature.payments.v2=on\nnot a pair\n"
+                        "feature.payments=off\nXDG_SESSION_TYPE=wayland\nfeature.search=on\nXDG=bare\nfeature.payments.refunds=off";
+    char buffer[100] = {0};
+    kv_pair pairs[16];
+    kv_keys keys;
+    const kv_pair *first;
+
+    // **Test 1: Build Sorts And Removes Duplicates**
+    assert(kv_keys_max(input) == 10);
+    assert(kv_keys_build(&keys, input, pairs, 4) == -1);
+    assert(kv_keys_build(&keys, input, pairs, 16) == 0);
+    assert(keys.count == 8);
+    for (size_t i = 1; i < keys.count; i++)
+    {
+        const size_t n = pairs[i - 1].key_len < pairs[i].key_len ? pairs[i - 1].key_len : pairs[i].key_len;
+        const int cmp = memcmp(pairs[i - 1].key, pairs[i].key, n);
+        assert(cmp < 0 || (cmp == 0 && pairs[i - 1].key_len < pairs[i].key_len));
+    }
+
+    // **Test 2: Prefix Queries**
+    assert(kv_keys_prefix(&keys, "XDG_", &first) == 2);
+    assert(first[0].key_len == strlen("XDG_CURRENT_DESKTOP") && memcmp(first[0].key, "XDG_CURRENT_DESKTOP", first[0].key_len) == 0);
+    assert(first[1].key_len == strlen("XDG_SESSION_TYPE") && memcmp(first[1].key, "XDG_SESSION_TYPE", first[1].key_len) == 0);
+    assert(kv_scan_unescape(first[1].value, first[1].value_len, first[1].flags, buffer, sizeof(buffer)) == 3);
+    assert(strcmp(buffer, "x11") == 0);
+    assert(kv_keys_prefix(&keys, "XDG", &first) == 3);
+    assert(kv_keys_prefix(&keys, "feature.payments", &first) == 3);
+    assert(kv_keys_prefix(&keys, "feature.payments.", &first) == 2);
+    assert(kv_keys_prefix(&keys, "missing", &first) == 0);
+    assert(kv_keys_prefix(&keys, "", &first) == keys.count && first == pairs);
+
+    // **Test 3: Range Queries**
+    assert(kv_keys_range(&keys, "feature.", "feature/", &first) == 4);
+    assert(kv_keys_range(&keys, NULL, "XDG", &first) == 1);
+    assert(first[0].key_len == 4 && memcmp(first[0].key, "HOME", 4) == 0);
+    assert(kv_keys_range(&keys, "XDG", NULL, &first) == 7);
+    assert(kv_keys_range(&keys, "z", "a", &first) == 0);
+    assert(kv_keys_range(&keys, NULL, NULL, &first) == keys.count);
+
+    // **Test 4: Empty Input**
+    assert(kv_keys_build(&keys, "", pairs, 16) == 0);
+    assert(keys.count == 0);
+    assert(kv_keys_prefix(&keys, "XDG_", &first) == 0);
+
+    printf("kv_keys_prefix() passed successfully!\n");
+}
+
+void run_kv_seek_index_tests()
+{
+    const char *path = "kv_seek_index_test.tmp";
+    static char input[128 * 1024];
+    char buffer[100] = {0};
+    uint64_t storage[64];
+    kv_seek_index index;
+
+    size_t len = sprintf(input, "  spaced = first \nquoted=\"a \\\"b\\\"\"\n\nno delimiter\na=b=1\nurl : http://host\n");
+    for (int i = 0; i < 3000; i++)
+    {
+        len += sprintf(input + len, "key%d=value%d\n%s", i, i, (i % 500 == 0) ? "spaced=duplicate\n" : "");
+    }
+    sprintf(input + len, "last=end");
+    write_test_file(path, input);
+    FILE *file = fopen(path, "r");
+    assert(file != NULL);
+
+    // **Test 1: Memory Limit Is Enforced**
+    assert(kv_seek_index_build(&index, file, storage, sizeof(storage[0]), 4) == -1);
+    assert(kv_seek_index_build(&index, file, storage, sizeof(storage), 0) == -1);
+    assert(kv_seek_index_build(&index, file, storage, sizeof(storage), 4) == 0);
+    assert(index.count * (1 + index.bloom_words) <= 64);
+    assert(index.block_lines * index.count >= 3000);
+
+    // **Test 2: Lookups Match kv_get_value()**
+    {
+        const char *keys[] = {"spaced", "quoted", "no delimiter", "key0", "key1", "key10", "key999", "key2999", "last", "key3000", "missing", "a", "a=b", "a=b ", "url", "url : http"};
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_value(input, keys[k], expected, sizeof(expected));
+            assert(kv_seek_index_get_value(&index, keys[k], buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+        for (int i = 0; i < 3000; i += 37)
+        {
+            char key[16];
+            char expected[32];
+            sprintf(key, "key%d", i);
+            sprintf(expected, "value%d", i);
+            assert(kv_seek_index_get_value(&index, key, buffer, sizeof(buffer)) == strlen(expected));
+            assert(strcmp(buffer, expected) == 0);
+        }
+        assert(kv_seek_index_get_value(&index, "key42", buffer, 4) == 0);
+        assert(kv_seek_index_get_value(&index, "a=b", buffer, sizeof(buffer)) == 1);
+        assert(strcmp(buffer, "1") == 0);
+    }
+
+    // **Test 3: One Block Covers The Whole File**
+    assert(kv_seek_index_build(&index, file, storage, 2 * sizeof(storage[0]), 1) == 0);
+    assert(index.count == 1);
+    assert(kv_seek_index_get_value(&index, "last", buffer, sizeof(buffer)) == 3);
+    assert(strcmp(buffer, "end") == 0);
+
+    fclose(file);
+
+    // **Test 4: Keys Containing A Delimiter Are In The Bloom Filter**
+    {
+        const char *delim_input = "x=0\na=b=1\nurl : http://host\n";
+        const char *keys[] = {"a", "a=b", "url", "url : http"};
+        write_test_file(path, delim_input);
+        file = fopen(path, "r");
+        assert(file != NULL);
+        assert(kv_seek_index_build(&index, file, storage, sizeof(storage), 1) == 0);
+        assert(index.count == 3);
+        for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+        {
+            char expected[100] = {0};
+            unsigned int expected_count = kv_get_value(delim_input, keys[k], expected, sizeof(expected));
+            assert(kv_seek_index_get_value(&index, keys[k], buffer, sizeof(buffer)) == expected_count);
+            assert(strcmp(buffer, expected) == 0);
+        }
+        assert(kv_seek_index_get_value(&index, "a=b", buffer, sizeof(buffer)) == 1);
+        fclose(file);
+    }
+
+    // **Test 5: Misses Read Few Blocks Of A File Far Larger Than The Index**
+    {
+        static uint64_t large_storage[4096];
+        const int lines = 20000;
+        file = fopen(path, "w");
+        assert(file != NULL);
+        for (int i = 0; i < lines; i++)
+        {
+            fprintf(file, "key%d=http://host:%d\n", i, i);
+        }
+        fclose(file);
+
+        file = fopen(path, "r");
+        assert(file != NULL);
+        assert(kv_seek_index_build(&index, file, large_storage, sizeof(large_storage), 4) == 0);
+        assert((size_t)lines > sizeof(large_storage) / sizeof(large_storage[0]) * 4);
+        assert(64 * index.bloom_words * index.count >= (size_t)KV_SEEK_INDEX_BITS_PER_KEY * lines);
+
+        size_t read = 0;
+        for (int i = 0; i < 200; i++)
+        {
+            char key[16];
+            sprintf(key, "miss%d", i);
+            const size_t candidates = kv_seek_index_candidates(&index, key);
+            assert(candidates <= index.count / 10);
+            read += candidates;
+        }
+        assert(read <= 200 * index.count / 20);
+
+        for (int i = 0; i < lines; i += 997)
+        {
+            char key[16];
+            char expected[32];
+            sprintf(key, "key%d", i);
+            sprintf(expected, "http://host:%d", i);
+            assert(kv_seek_index_candidates(&index, key) >= 1);
+            assert(kv_seek_index_get_value(&index, key, buffer, sizeof(buffer)) == strlen(expected));
+            assert(strcmp(buffer, expected) == 0);
+        }
+        fclose(file);
+    }
+    remove(path);
+
+    printf("kv_seek_index_get_value() passed successfully!\n");
+}
+
+void run_kv_get_value_variants_tests()
+{
+    const char *input = " key = value \nx=1\nx=2\npath=\"/home/\\\"user=data\"\nlongkey=longvalue\r\nempty=\nuncapped=\"tail   \nname:'single'";
+    const char *keys[] = {"key", " key", "x", "path", "longkey", "empty", "uncapped", "name", "missing"};
+    char buffer[100] = {0};
+    kv_parser parser;
+
+    // **Test 1: Variant Matching The Build Flags Matches kv_get_value()**
+    unsigned int options = 0;
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    options |= KV_PARSE_WHITESPACE_SKIP;
+#endif
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    options |= KV_PARSE_QUOTED_STRINGS;
+#endif
+    kv_parser_init(&parser, options);
+    for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+    {
+        char expected[100] = {0};
+        unsigned int expected_count = kv_get_value(input, keys[k], expected, sizeof(expected));
+        buffer[0] = '\0';
+        assert(kv_parser_get_value(&parser, input, keys[k], buffer, sizeof(buffer)) == expected_count);
+        assert(strcmp(buffer, expected) == 0);
+    }
+
+    // **Test 2: All Variants Coexist In One Binary**
+    assert(kv_get_value_strict(input, "key", buffer, sizeof(buffer)) == 0);
+    assert(kv_get_value_strict(input, " key ", buffer, sizeof(buffer)) == 7);
+    assert(strcmp(buffer, " value ") == 0);
+    assert(kv_get_value_ws(input, "key", buffer, sizeof(buffer)) == 5);
+    assert(strcmp(buffer, "value") == 0);
+    assert(kv_get_value_ws(input, "name", buffer, sizeof(buffer)) == 8);
+    assert(strcmp(buffer, "'single'") == 0);
+    assert(kv_get_value_quoted(input, "name", buffer, sizeof(buffer)) == 6);
+    assert(strcmp(buffer, "single") == 0);
+    assert(kv_get_value_quoted(input, "key", buffer, sizeof(buffer)) == 0);
+    assert(kv_get_value_full(input, "path", buffer, sizeof(buffer)) == 16);
+    assert(strcmp(buffer, "/home/\"user=data") == 0);
+
+    // **Test 3: Selection**
+    assert(kv_get_value_select(0) == kv_get_value_strict);
+    assert(kv_get_value_select(KV_PARSE_WHITESPACE_SKIP) == kv_get_value_ws);
+    assert(kv_get_value_select(KV_PARSE_QUOTED_STRINGS) == kv_get_value_quoted);
+    assert(kv_get_value_select(KV_PARSE_WHITESPACE_SKIP | KV_PARSE_QUOTED_STRINGS) == kv_get_value_full);
+
+    printf("kv_parser_get_value() passed successfully!\n");
+}
+
+static void read_test_file(const char *path, char *contents, size_t max)
+{
+    FILE *file = fopen(path, "rb");
+    assert(file != NULL);
+    const size_t len = fread(contents, 1, max - 1, file);
+    contents[len] = '\0';
+    fclose(file);
+}
+
+void run_kv_writer_tests()
+{
+    const char *path = "kv_writer_test.tmp";
+    char contents[512];
+    char buffer[100] = {0};
+    kv_edit edits[4];
+    kv_txn txn;
+
+    // **Test 1: Transaction Applied In One Pass**
+    write_test_file(path, "# comment line\nmode=slow\nname=old\r\nlegacy=1\nkeep=yes\nlegacy=2\nmode=shadowed");
+    chmod(path, 0640);
+    kv_txn_init(&txn, edits, 4);
+    assert(kv_txn_set(&txn, "mode", "fast") == 0);
+    assert(kv_txn_set(&txn, "name", "first") == 0);
+    assert(kv_txn_set(&txn, "name", "new") == 0);
+    assert(kv_txn_delete(&txn, "legacy") == 0);
+    assert(kv_txn_set(&txn, "added", "value") == 0);
+    assert(kv_txn_set(&txn, "full", "x") == -1);
+    assert(kv_txn_commit(&txn, path) == 0);
+
+    read_test_file(path, contents, sizeof(contents));
+    assert(strcmp(contents, "# comment line\nmode=fast\nname=new\r\nkeep=yes\nmode=shadowed\nadded=value\n") == 0);
+    assert(kv_get_value(contents, "mode", buffer, sizeof(buffer)) == 4);
+    assert(strcmp(buffer, "fast") == 0);
+    {
+        struct stat st;
+        assert(stat(path, &st) == 0);
+        assert((st.st_mode & 0777) == 0640);
+    }
+
+    // **Test 2: Invalid Keys And Values Are Rejected**
+    kv_txn_init(&txn, edits, 4);
+    assert(kv_txn_set(&txn, "a=b", "1") == -1);
+    assert(kv_txn_set(&txn, "a:b", "1") == -1);
+    assert(kv_txn_set(&txn, "", "1") == -1);
+    assert(kv_txn_set(&txn, "line", "1\n2") == -1);
+    assert(kv_txn_delete(&txn, "a\nb") == -1);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    // **Test 3: Whitespace Layout Is Kept**
+    write_test_file(path, "  key  =  old  \nother=1\n");
+    assert(kv_set_value(path, "key", "new") == 0);
+    read_test_file(path, contents, sizeof(contents));
+    assert(strcmp(contents, "  key  =  new\nother=1\n") == 0);
+#endif
+
+#if !defined(KV_PARSE_DISABLE_WHITESPACE_SKIP) && !defined(KV_PARSE_DISABLE_QUOTED_STRINGS)
+    // **Test 4: Values Are Quoted To Read Back Unchanged**
+    {
+        const char *values[] = {"  padded  ", "say \"hi\"", "it's", "back\\slash", "a\\\"b"};
+        for (size_t v = 0; v < sizeof(values) / sizeof(values[0]); v++)
+        {
+            assert(kv_set_value(path, "quoted", values[v]) == 0);
+            read_test_file(path, contents, sizeof(contents));
+            assert(kv_get_value(contents, "quoted", buffer, sizeof(buffer)) == strlen(values[v]));
+            assert(strcmp(buffer, values[v]) == 0);
+        }
+        assert(kv_set_value(path, "quoted", "ends with \" \\") == -1);
+    }
+#endif
+
+    // **Test 5: Symbolic Link Is Followed And Kept**
+    {
+        const char *link_path = "kv_writer_link.tmp";
+        write_test_file(path, "mode=slow\n");
+        remove(link_path);
+        assert(symlink(path, link_path) == 0);
+        assert(kv_set_value(link_path, "mode", "fast") == 0);
+        struct stat st;
+        assert(lstat(link_path, &st) == 0 && S_ISLNK(st.st_mode));
+        read_test_file(path, contents, sizeof(contents));
+        assert(strcmp(contents, "mode=fast\n") == 0);
+        remove(link_path);
+    }
+
+    // **Test 6: Missing File Is Created, Keys Deleted**
+    remove(path);
+    assert(kv_set_value(path, "first", "1") == 0);
+    assert(kv_set_value(path, "second", "2") == 0);
+    assert(kv_delete_key(path, "first") == 0);
+    assert(kv_delete_key(path, "missing") == 0);
+    read_test_file(path, contents, sizeof(contents));
+    assert(strcmp(contents, "second=2\n") == 0);
+    {
+        FILE *file = fopen(path, "r");
+        assert(file != NULL);
+        assert(kv_file_get_value(file, "second", buffer, sizeof(buffer)) == 1);
+        fclose(file);
+    }
+    remove(path);
+
+    printf("kv_txn_commit() passed successfully!\n");
+}
+
+void run_kv_bulk_tests()
+{
+    enum
+    {
+        FILES = 48,
+        PATHS = FILES + 1,
+        KEYS = 3,
+        MAX = 32
+    };
+    char paths_storage[PATHS][64];
+    const char *paths[PATHS];
+    char contents[FILES][128];
+    const char *keys[KEYS] = {"id", "mode", "absent"};
+    static char values[PATHS * KEYS * MAX];
+    unsigned int lens[PATHS * KEYS];
+    int status[PATHS];
+    char buffer[MAX];
+
+    for (unsigned int p = 0; p < FILES; p++)
+    {
+        snprintf(paths_storage[p], sizeof(paths_storage[p]), "kv_bulk_test_%u.tmp", p);
+        snprintf(contents[p], sizeof(contents[p]), "# file %u\nid=%u\nmode=%s\n", p, p * 7, (p % 2) ? "odd" : "even");
+        write_test_file(paths_storage[p], contents[p]);
+        paths[p] = paths_storage[p];
+    }
+    paths[FILES] = "kv_bulk_test_missing.tmp";
+
+    // **Test 1: Every File Matches kv_get_value(), Whatever The Thread Count**
+    const unsigned int thread_counts[] = {0, 1, 4, 100};
+    for (size_t t = 0; t < sizeof(thread_counts) / sizeof(thread_counts[0]); t++)
+    {
+        memset(values, 'x', sizeof(values));
+        assert(kv_bulk_get_values(paths, PATHS, keys, KEYS, values, MAX, lens, status, thread_counts[t]) == FILES);
+        for (unsigned int p = 0; p < FILES; p++)
+        {
+            assert(status[p] == 0);
+            for (unsigned int k = 0; k < KEYS; k++)
+            {
+                const unsigned int expected = kv_get_value(contents[p], keys[k], buffer, sizeof(buffer));
+                assert(lens[p * KEYS + k] == expected);
+                assert(strcmp(values + (p * KEYS + k) * MAX, expected ? buffer : "") == 0);
+            }
+        }
+        assert(status[FILES] == -1);
+        for (unsigned int k = 0; k < KEYS; k++)
+        {
+            assert(lens[FILES * KEYS + k] == 0);
+            assert(values[(FILES * KEYS + k) * MAX] == '\0');
+        }
+    }
+    assert(strcmp(values + (5 * KEYS + 1) * MAX, "odd") == 0);
+
+    // **Test 2: No Keys Still Reports Which Files Were Read**
+    assert(kv_bulk_get_values(paths, PATHS, keys, 0, values, MAX, lens, status, 4) == FILES);
+    assert(status[0] == 0 && status[FILES] == -1);
+
+    // **Test 3: No Paths**
+    assert(kv_bulk_get_values(paths, 0, keys, KEYS, values, MAX, lens, status, 0) == 0);
+
+    // **Test 4: More Keys Than One Batch**
+    {
+        enum
+        {
+            MANY = KV_GET_VALUES_BATCH * 2 + 5
+        };
+        static char many_names[MANY][16];
+        static const char *many_keys[MANY];
+        static char many_values[2 * MANY * MAX];
+        static unsigned int many_lens[2 * MANY];
+        for (unsigned int k = 0; k < MANY; k++)
+        {
+            snprintf(many_names[k], sizeof(many_names[k]), "k%u", k);
+            many_keys[k] = many_names[k];
+        }
+        many_keys[MANY - 1] = "mode";
+        assert(kv_bulk_get_values(paths, 2, many_keys, MANY, many_values, MAX, many_lens, status, 2) == 2);
+        for (unsigned int k = 0; k + 1 < MANY; k++)
+        {
+            assert(many_lens[k] == 0 && many_lens[MANY + k] == 0);
+        }
+        assert(strcmp(many_values + (MANY - 1) * MAX, "even") == 0);
+        assert(strcmp(many_values + (2 * MANY - 1) * MAX, "odd") == 0);
+    }
+
+    for (unsigned int p = 0; p < FILES; p++)
+    {
+        remove(paths_storage[p]);
+    }
+
+    printf("kv_bulk_get_values() passed successfully!\n");
+}
+
+void run_kv_records_tests()
+{
+    char buffer[100] = {0};
+    kv_separators nul, lines, comma;
+    kv_separators_init(&nul, "\0", 1);
+    kv_separators_init(&lines, "\r\n", 2);
+    kv_separators_init(&comma, ",;,", 3);
+    assert(nul.count == 1 && lines.count == 2 && comma.count == 2);
+
+    // **Test 1: NUL Separated Environ Block**
+    const char environ_block[] = "HOME=/root\0PATH=/usr/bin:/bin\0OPTS=a=b=c\0EMPTY=\0PATHX=no\0LAST=end";
+    const size_t environ_len = sizeof(environ_block) - 1;
+    assert(kv_get_value_sep(environ_block, environ_len, &nul, "HOME", buffer, sizeof(buffer)) == 5);
+    assert(strcmp(buffer, "/root") == 0);
+    assert(kv_get_value_sep(environ_block, environ_len, &nul, "PATH", buffer, sizeof(buffer)) == 13);
+    assert(strcmp(buffer, "/usr/bin:/bin") == 0);
+    assert(kv_get_value_sep(environ_block, environ_len, &nul, "OPTS", buffer, sizeof(buffer)) == 5);
+    assert(strcmp(buffer, "a=b=c") == 0);
+    assert(kv_get_value_sep(environ_block, environ_len, &nul, "LAST", buffer, sizeof(buffer)) == 3);
+    assert(strcmp(buffer, "end") == 0);
+    assert(kv_get_value_sep(environ_block, environ_len, &nul, "MISSING", buffer, sizeof(buffer)) == 0);
+    assert(kv_get_value_sep(environ_block, environ_len, &nul, "PAT", buffer, sizeof(buffer)) == 0);
+
+    // **Test 2: Empty Value Told Apart From Missing Key**
+    kv_value_view view = kv_get_value_view_sep(environ_block, environ_len, &nul, "EMPTY");
+    assert(view.ptr != NULL && view.len == 0);
+    view = kv_get_value_view_sep(environ_block, environ_len, &nul, "NOPE");
+    assert(view.ptr == NULL);
+
+    // **Test 3: Length Bounds The Search, Not NUL**
+    assert(kv_get_value_sep(environ_block, 10, &nul, "HOME", buffer, sizeof(buffer)) == 5);
+    assert(kv_get_value_sep(environ_block, 8, &nul, "HOME", buffer, sizeof(buffer)) == 3);
+    assert(strcmp(buffer, "/ro") == 0);
+    assert(kv_get_value_sep(environ_block, 10, &nul, "PATH", buffer, sizeof(buffer)) == 0);
+    assert(kv_get_value_sep(environ_block, 0, &nul, "HOME", buffer, sizeof(buffer)) == 0);
+
+    // **Test 4: Line Separators Match kv_get_value()**
+    {
+        const char *inputs[] = {"a=1\nb=2\r\nc=three\n", "key=value", "# comment\nx:\"quoted\"\n", "x=1\nx=2"};
+        const char *keys[] = {"a", "b", "c", "key", "x", "missing"};
+        for (size_t i = 0; i < sizeof(inputs) / sizeof(inputs[0]); i++)
+        {
+            for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+            {
+                char expected[100];
+                const unsigned int expected_len = kv_get_value(inputs[i], keys[k], expected, sizeof(expected));
+                assert(kv_get_value_sep(inputs[i], strlen(inputs[i]), &lines, keys[k], buffer, sizeof(buffer)) == expected_len);
+                assert(expected_len == 0 || strcmp(buffer, expected) == 0);
+            }
+        }
+    }
+
+    // **Test 5: Several Separators, Newline Is Then Ordinary Data**
+    const char *csv = "a=1,b=2;c=x\ny";
+    assert(kv_get_value_sep(csv, strlen(csv), &comma, "b", buffer, sizeof(buffer)) == 1);
+    assert(strcmp(buffer, "2") == 0);
+    assert(kv_get_value_sep(csv, strlen(csv), &comma, "c", buffer, sizeof(buffer)) == 3);
+    assert(strcmp(buffer, "x\ny") == 0);
+
+#ifndef KV_PARSE_DISABLE_WHITESPACE_SKIP
+    // **Test 6: Whitespace Around Keys And Values**
+    const char spaced[] = "  name =  padded  \0other=1";
+    assert(kv_get_value_sep(spaced, sizeof(spaced) - 1, &nul, "name", buffer, sizeof(buffer)) == 6);
+    assert(strcmp(buffer, "padded") == 0);
+#endif
+
+#ifndef KV_PARSE_DISABLE_QUOTED_STRINGS
+    // **Test 7: Quoted Values**
+    const char quoted[] = "q=\"a b\"\0e=x \"y\\\"z\"\0";
+    assert(kv_get_value_sep(quoted, sizeof(quoted) - 1, &nul, "q", buffer, sizeof(buffer)) == 3);
+    assert(strcmp(buffer, "a b") == 0);
+    assert(kv_get_value_sep(quoted, sizeof(quoted) - 1, &nul, "e", buffer, sizeof(buffer)) == 5);
+    assert(strcmp(buffer, "x y\"z") == 0);
+#endif
+
+    printf("kv_get_value_sep() passed successfully!\n");
+}
+
+static const char *kv_key_test_inputs[] = {
+    "username=admin\npassword=1234\nuser=short",
+    "# comment\n  user : padded  \nuser=second\nuserX=no",
+    "a_rather_long_key_name_over_16=long value\na_rather_long_key_name_over_17=other",
+    "usernam=x\nusername_extra=y\nusername",
+    "quoted=\"a \\\"b\\\" c\" tail\r\nnext=1",
+    "user=name=1\nurl : http://host",
+    "",
+};
+static const char *kv_key_test_keys[] = {"user", "username", "password", "userX", "a_rather_long_key_name_over_16", "a_rather_long_key_name_over_17", "quoted", "next", "missing", "u", "user=name", "url : http"};
+#define KV_KEY_TEST_NKEYS (sizeof(kv_key_test_keys) / sizeof(kv_key_test_keys[0]))
+
+/* Looks up every compiled key in every input and checks it against kv_get_value() */
+static void *kv_key_test_thread(void *arg)
+{
+    const kv_key *keys = arg;
+    char expected[100];
+    char buffer[100];
+    for (int round = 0; round < 200; round++)
+    {
+        for (size_t i = 0; i < sizeof(kv_key_test_inputs) / sizeof(kv_key_test_inputs[0]); i++)
+        {
+            for (size_t k = 0; k < KV_KEY_TEST_NKEYS; k++)
+            {
+                const unsigned int expected_len = kv_get_value(kv_key_test_inputs[i], kv_key_test_keys[k], expected, sizeof(expected));
+                assert(kv_get_value_k(kv_key_test_inputs[i], &keys[k], buffer, sizeof(buffer)) == expected_len);
+                assert(expected_len == 0 || strcmp(buffer, expected) == 0);
+            }
+        }
+    }
+    return NULL;
+}
+
+void run_kv_key_tests()
+{
+    kv_key keys[KV_KEY_TEST_NKEYS];
+    char expected[100];
+    char buffer[100];
+    for (size_t k = 0; k < KV_KEY_TEST_NKEYS; k++)
+    {
+        keys[k] = kv_key_compile(kv_key_test_keys[k]);
+        assert(keys[k].len == strlen(kv_key_test_keys[k]));
+    }
+
+    // **Test 1: Matches kv_get_value() At Every Alignment**
+    kv_key_test_thread(keys);
+    for (size_t shift = 0; shift < 16; shift++)
+    {
+        char shifted[128] = {0};
+        memcpy(shifted + shift, kv_key_test_inputs[0], strlen(kv_key_test_inputs[0]));
+        assert(kv_get_value_k(shifted + shift, &keys[1], buffer, sizeof(buffer)) == 5);
+        assert(strcmp(buffer, "admin") == 0);
+        assert(kv_get_value_k(shifted + shift, &keys[0], buffer, sizeof(buffer)) == 5);
+        assert(strcmp(buffer, "short") == 0);
+    }
+
+    // **Test 2: Value Too Large Is Not Returned**
+    assert(kv_get_value_k("username=admin", &keys[1], buffer, 5) == 0);
+    assert(buffer[0] == '\0');
+
+    // **Test 3: Shared Across Threads**
+    {
+        pthread_t threads[4];
+        for (int t = 0; t < 4; t++)
+        {
+            assert(pthread_create(&threads[t], NULL, kv_key_test_thread, keys) == 0);
+        }
+        for (int t = 0; t < 4; t++)
+        {
+            pthread_join(threads[t], NULL);
+        }
+    }
+
+    // **Test 4: File Streams**
+    {
+        const char *path = "kv_key_test.tmp";
+        for (size_t i = 0; i < sizeof(kv_key_test_inputs) / sizeof(kv_key_test_inputs[0]); i++)
+        {
+            write_test_file(path, kv_key_test_inputs[i]);
+            FILE *file = fopen(path, "r");
+            assert(file != NULL);
+            for (size_t k = 0; k < KV_KEY_TEST_NKEYS; k++)
+            {
+                const unsigned int expected_len = kv_get_value(kv_key_test_inputs[i], kv_key_test_keys[k], expected, sizeof(expected));
+                assert(kv_file_get_value_k(file, &keys[k], buffer, sizeof(buffer)) == expected_len);
+                assert(expected_len == 0 || strcmp(buffer, expected) == 0);
+            }
+            fclose(file);
+        }
+        remove(path);
+    }
+
+    // **Test 5: Index Lookups Reuse The Hash**
+    {
+        kv_index_entry slots[16];
+        kv_index index;
+        assert(kv_index_build(&index, kv_key_test_inputs[0], slots, 16) == 0);
+        assert(keys[2].hash == kv_index_hash("password", 8));
+        assert(kv_index_find_k(&index, &keys[2]) == kv_index_find(&index, "password"));
+        assert(kv_index_get_value_k(&index, &keys[2], buffer, sizeof(buffer)) == 4);
+        assert(strcmp(buffer, "1234") == 0);
+        assert(kv_index_get_value_k(&index, &keys[8], buffer, sizeof(buffer)) == 0);
+    }
+
+    printf("kv_get_value_k() passed successfully!\n");
+}
+
+void run_kv_static_index_tests()
+{
+    static kv_static_index index;
+    char buffer[100] = {0};
+    char expected[100];
+
+    // **Test 1: Matches kv_get_value()**
+    const char *input = "# settings\nbaud=9600\nparity: none\nname=\"dev 1\"\nbaud=115200\nempty=\nnoline\nstop=1\na=b=1\nurl : http://h:80";
+    const char *keys[] = {"baud", "parity", "name", "empty", "noline", "stop", "missing", "bau", "a", "a=b", "url", "url : http", "baud ", "a=c"};
+    assert(kv_static_index_build(&index, input) == 0);
+    assert(index.count == 7);
+    for (size_t k = 0; k < sizeof(keys) / sizeof(keys[0]); k++)
+    {
+        const unsigned int expected_len = kv_get_value(input, keys[k], expected, sizeof(expected));
+        assert(kv_static_index_get_value(&index, keys[k], buffer, sizeof(buffer)) == expected_len);
+        assert(expected_len == 0 || strcmp(buffer, expected) == 0);
+    }
+    assert(kv_static_index_get_value(&index, "baud", buffer, sizeof(buffer)) == 4);
+    assert(strcmp(buffer, "9600") == 0);
+    assert(kv_static_index_get_value(&index, "a=b", buffer, sizeof(buffer)) == 1);
+    assert(strcmp(buffer, "1") == 0);
+    for (unsigned int i = 1; i < index.count; i++)
+    {
+        assert(index.hashes[i - 1] <= index.hashes[i]);
+    }
+
+    // **Test 2: Filled To Capacity, Then One Key Too Many**
+    {
+        static char many[KV_STATIC_INDEX_CAPACITY * 16 + 16];
+        size_t len = 0;
+        for (unsigned int i = 0; i < KV_STATIC_INDEX_CAPACITY; i++)
+        {
+            len += sprintf(many + len, "k%u=%u\n", i, i * 3);
+        }
+        assert(kv_static_index_build(&index, many) == 0);
+        assert(index.count == KV_STATIC_INDEX_CAPACITY);
+        for (unsigned int i = 0; i < KV_STATIC_INDEX_CAPACITY; i++)
+        {
+            char key[16];
+            sprintf(key, "k%u", i);
+            assert(kv_static_index_get_value(&index, key, buffer, sizeof(buffer)) == kv_get_value(many, key, expected, sizeof(expected)));
+            assert(strcmp(buffer, expected) == 0);
+        }
+        sprintf(many + len, "k0=dup\n");
+        assert(kv_static_index_build(&index, many) == 0);
+        sprintf(many + len, "extra=1\n");
+        assert(kv_static_index_build(&index, many) == -1);
+    }
+
+    // **Test 3: Limits Of The 16 And 8 Bit Fields**
+    {
+        static char big[KV_STATIC_INDEX_STR_MAX + 2];
+        memset(big, '#', sizeof(big) - 1);
+        assert(kv_static_index_build(&index, big) == -1);
+        big[KV_STATIC_INDEX_STR_MAX] = '\0';
+        memcpy(big + KV_STATIC_INDEX_STR_MAX - 4, "\na=1", 4);
+        assert(kv_static_index_build(&index, big) == 0);
+        assert(kv_static_index_get_value(&index, "a", buffer, sizeof(buffer)) == 1);
+
+        memset(big, 'k', KV_STATIC_INDEX_KEY_MAX + 1);
+        strcpy(big + KV_STATIC_INDEX_KEY_MAX + 1, "=1");
+        assert(kv_static_index_build(&index, big) == -1);
+        assert(kv_static_index_build(&index, big + 1) == 0);
+        assert(kv_static_index_get_value(&index, big, buffer, sizeof(buffer)) == 0);
+    }
+
+    printf("kv_static_index_get_value() passed successfully!\n");
+}
+
 // Run tests in main()
 int main()
 {
     run_kv_get_value_tests();
     run_kv_file_get_value_tests();
+    run_kv_index_tests();
+    run_kv_get_values_tests();
+    run_kv_mapped_file_tests();
+    run_kv_get_value_view_tests();
+    run_kv_stream_tests();
+    run_kv_foreach_tests();
+    run_kv_file_cache_tests();
+    run_kv_snapshot_tests();
+    run_kv_index_parallel_tests();
+    run_kv_compiled_tests();
+    run_kv_store_tests();
+    run_kv_get_typed_tests();
+    run_kv_section_tests();
+    run_kv_stats_tests();
+    run_kv_sorted_tests();
+    run_kv_keys_tests();
+    run_kv_seek_index_tests();
+    run_kv_get_value_variants_tests();
+    run_kv_writer_tests();
+    run_kv_bulk_tests();
+    run_kv_records_tests();
+    run_kv_key_tests();
+    run_kv_static_index_tests();
     printf("All tests passed successfully!\n");
     return 0;
 }